@@ -0,0 +1,403 @@
+#include "unrealsdk/pch.h"
+#include "unrealsdk/call_trace.h"
+#include "unrealsdk/unreal/classes/ufunction.h"
+#include "unrealsdk/unreal/classes/uobject.h"
+#include "unrealsdk/unreal/structs/fname.h"
+
+#ifndef UNREALSDK_IMPORTING
+
+using namespace unrealsdk::unreal;
+
+namespace unrealsdk::call_trace {
+
+namespace {
+
+#pragma region File Format
+
+// See `tools/convert_call_trace.py` for a full description of the format
+
+const constexpr std::array<char, 8> FILE_MAGIC = {'U', 'S', 'D', 'K', 'C', 'A', 'L', 'L'};
+const constexpr uint32_t FILE_VERSION = 1;
+
+enum class BlockType : uint8_t {
+    SOURCE = 1,
+    NAME = 2,
+    CALLS = 3,
+};
+
+struct CallRecord {
+    uint64_t timestamp;
+    // Pointers are always stored as 64-bit, so the format's the same across all flavours
+    uint64_t func;
+    uint64_t obj;
+    uint32_t thread_id;
+    int32_t func_name;
+    int32_t obj_name;
+    uint8_t source;
+    std::array<uint8_t, 3> padding;
+};
+static_assert(sizeof(CallRecord) == 40, "Call record has unexpected padding");
+
+#pragma endregion
+
+#pragma region Thread Buffers
+
+// Must be a power of two, so that the indexes wrap cleanly
+const constexpr size_t BUFFER_SIZE = 0x2000;
+
+struct ThreadBuffer {
+    // Single producer (the owning thread), single consumer (the writer thread) ring buffer
+    std::array<CallRecord, BUFFER_SIZE> records{};
+    std::atomic<size_t> head = 0;
+    std::atomic<size_t> tail = 0;
+    std::atomic<size_t> dropped = 0;
+
+    uint32_t thread_id = GetCurrentThreadId();
+
+    // Everything below is only ever accessed from the owning thread
+
+    // The session the below caches are valid for
+    uint64_t session = 0;
+    // Maps objects we've already written the name of to the name index they had
+    std::unordered_map<const UObject*, int32_t> seen_names;
+    std::vector<std::pair<std::wstring_view, uint8_t>> known_sources;
+};
+
+std::mutex buffers_mutex{};
+std::vector<std::shared_ptr<ThreadBuffer>> buffers{};
+
+/**
+ * @brief Gets the current thread's buffer, creating it if needed.
+ *
+ * @return The buffer.
+ */
+ThreadBuffer& get_thread_buffer(void) {
+    thread_local std::shared_ptr<ThreadBuffer> thread_buffer{};
+    if (thread_buffer == nullptr) {
+        thread_buffer = std::make_shared<ThreadBuffer>();
+
+        const std::scoped_lock lock(buffers_mutex);
+        buffers.push_back(thread_buffer);
+    }
+    return *thread_buffer;
+}
+
+#pragma endregion
+
+std::atomic<bool> active = false;
+std::atomic<uint64_t> current_session = 0;
+
+struct NameEntry {
+    uint64_t obj;
+    int32_t name_index;
+    std::wstring name;
+};
+
+std::mutex names_mutex{};
+std::vector<NameEntry> pending_names{};
+
+std::mutex sources_mutex{};
+std::vector<std::wstring> sources{};
+
+// Only accessed from the writer thread, or while it's stopped
+std::ofstream trace_stream{};
+size_t sources_written = 0;
+
+std::mutex control_mutex{};
+std::jthread writer_thread{};
+
+const constexpr auto FLUSH_INTERVAL = std::chrono::milliseconds{50};
+
+/**
+ * @brief Gets the index of an fname.
+ *
+ * @param name The name.
+ * @return It's index.
+ */
+int32_t get_name_index(FName name) {
+    // The index is the first field
+    int32_t index{};
+    memcpy(&index, &name, sizeof(index));
+    return index;
+}
+
+/**
+ * @brief Gets the id of the given call source, interning it if not already known.
+ *
+ * @param buffer The current thread's buffer.
+ * @param source The call source.
+ * @return The source id.
+ */
+uint8_t get_source_id(ThreadBuffer& buffer, std::wstring_view source) {
+    for (const auto& [known_source, id] : buffer.known_sources) {
+        if (known_source == source) {
+            return id;
+        }
+    }
+
+    const std::scoped_lock lock(sources_mutex);
+
+    auto iter = std::ranges::find(sources, source);
+    auto id = static_cast<uint8_t>(std::distance(sources.begin(), iter));
+    if (iter == sources.end()) {
+        sources.emplace_back(source);
+    }
+
+    // Sources are always string literals, so it's safe to store the view
+    buffer.known_sources.emplace_back(source, id);
+    return id;
+}
+
+/**
+ * @brief Queues writing the name of an object, if we haven't already done so.
+ *
+ * @param buffer The current thread's buffer.
+ * @param obj The object to write the name of.
+ * @param name_index The index of the object's fname.
+ */
+void resolve_name(ThreadBuffer& buffer, const UObject* obj, int32_t name_index) {
+    auto [iter, inserted] = buffer.seen_names.try_emplace(obj, name_index);
+    if (!inserted) {
+        // If the name index is different, the object got freed, and something else reused it's
+        // address - so we need to write it again
+        if (iter->second == name_index) {
+            return;
+        }
+        iter->second = name_index;
+    }
+
+    // Resolve the name straight away, on the calling thread. Doing it later on the writer thread is
+    // unsafe, since the object may have been garbage collected by then.
+    NameEntry entry{.obj = reinterpret_cast<uintptr_t>(obj),
+                    .name_index = name_index,
+                    .name = obj->get_path_name()};
+
+    const std::scoped_lock lock(names_mutex);
+    pending_names.push_back(std::move(entry));
+}
+
+/**
+ * @brief Writes a trivially copyable value to the trace file.
+ *
+ * @tparam T The type of the value.
+ * @param value The value.
+ */
+template <typename T>
+void write_value(const T& value) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    trace_stream.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+/**
+ * @brief Writes a length-prefixed string to the trace file.
+ *
+ * @param str The string to write.
+ */
+void write_string(std::wstring_view str) {
+    write_value(static_cast<uint32_t>(str.size()));
+    trace_stream.write(reinterpret_cast<const char*>(str.data()),
+                       static_cast<std::streamsize>(str.size() * sizeof(wchar_t)));
+}
+
+/**
+ * @brief Writes everything currently waiting in the buffers to the trace file.
+ */
+void drain(void) {
+    {
+        const std::scoped_lock lock(sources_mutex);
+        for (; sources_written < sources.size(); sources_written++) {
+            write_value(BlockType::SOURCE);
+            write_value(static_cast<uint8_t>(sources_written));
+            write_string(sources[sources_written]);
+        }
+    }
+
+    // Since names are queued separately, a call may get written before the names it refers to -
+    // readers need to look at the whole file before resolving any names
+    std::vector<NameEntry> names{};
+    {
+        const std::scoped_lock lock(names_mutex);
+        std::swap(names, pending_names);
+    }
+    for (const auto& entry : names) {
+        write_value(BlockType::NAME);
+        write_value(entry.obj);
+        write_value(entry.name_index);
+        write_string(entry.name);
+    }
+
+    std::vector<std::shared_ptr<ThreadBuffer>> current_buffers{};
+    {
+        const std::scoped_lock lock(buffers_mutex);
+        current_buffers = buffers;
+    }
+
+    for (const auto& buffer : current_buffers) {
+        auto tail = buffer->tail.load(std::memory_order_relaxed);
+        auto head = buffer->head.load(std::memory_order_acquire);
+        if (head == tail) {
+            continue;
+        }
+
+        write_value(BlockType::CALLS);
+        write_value(static_cast<uint32_t>(head - tail));
+
+        // Write in at most two contiguous chunks, before and after wrapping around
+        while (tail != head) {
+            auto start = tail % BUFFER_SIZE;
+            auto count = std::min(head - tail, BUFFER_SIZE - start);
+            trace_stream.write(reinterpret_cast<const char*>(&buffer->records[start]),
+                               static_cast<std::streamsize>(count * sizeof(CallRecord)));
+            tail += count;
+        }
+
+        buffer->tail.store(tail, std::memory_order_release);
+    }
+    current_buffers.clear();
+
+    trace_stream.flush();
+
+    // Clean up the buffers of any threads which have exited
+    const std::scoped_lock lock(buffers_mutex);
+    std::erase_if(buffers, [](auto& buffer) {
+        return buffer.use_count() == 1
+               && buffer->head.load(std::memory_order_acquire)
+                      == buffer->tail.load(std::memory_order_relaxed);
+    });
+}
+
+/**
+ * @brief Main function of the writer thread.
+ *
+ * @param stop_token Stop token used to stop the thread.
+ */
+void writer_main(const std::stop_token& stop_token) {
+    std::mutex wake_mutex{};
+    std::condition_variable_any wake_cv{};
+
+    while (!stop_token.stop_requested()) {
+        drain();
+
+        std::unique_lock lock(wake_mutex);
+        wake_cv.wait_for(lock, stop_token, FLUSH_INTERVAL, [] { return false; });
+    }
+
+    // Final drain to catch anything written since the last one
+    drain();
+}
+
+/**
+ * @brief Stops the trace.
+ * @note Assumes the control mutex is held.
+ */
+void stop_locked(void) {
+    if (!active.exchange(false)) {
+        return;
+    }
+
+    writer_thread.request_stop();
+    writer_thread.join();
+    trace_stream.close();
+
+    size_t total_dropped = 0;
+    {
+        const std::scoped_lock lock(buffers_mutex);
+        for (const auto& buffer : buffers) {
+            total_dropped += buffer->dropped.exchange(0, std::memory_order_relaxed);
+        }
+    }
+    if (total_dropped > 0) {
+        LOG(WARNING, "Call trace dropped {} calls, since they were made faster than it could write",
+            total_dropped);
+    }
+}
+
+}  // namespace
+
+void start(const std::filesystem::path& path) {
+    const std::scoped_lock lock(control_mutex);
+    stop_locked();
+
+    trace_stream.open(path, std::ofstream::binary | std::ofstream::trunc);
+    if (!trace_stream.is_open()) {
+        LOG(ERROR, "Failed to open call trace file: {}", path.string());
+        return;
+    }
+
+    LARGE_INTEGER frequency{};
+    QueryPerformanceFrequency(&frequency);
+
+    write_value(FILE_MAGIC);
+    write_value(FILE_VERSION);
+    write_value(static_cast<uint16_t>(sizeof(CallRecord)));
+    write_value(static_cast<uint16_t>(sizeof(wchar_t)));
+    write_value(static_cast<uint64_t>(frequency.QuadPart));
+
+    // Start a new session, so that threads forget what names they've already written
+    current_session.fetch_add(1, std::memory_order_relaxed);
+    sources_written = 0;
+    {
+        const std::scoped_lock names_lock(names_mutex);
+        pending_names.clear();
+    }
+    {
+        // Discard anything left over from the last session
+        const std::scoped_lock buffers_lock(buffers_mutex);
+        for (const auto& buffer : buffers) {
+            buffer->tail.store(buffer->head.load(std::memory_order_acquire),
+                               std::memory_order_release);
+        }
+    }
+
+    writer_thread = std::jthread{writer_main};
+    active.store(true);
+}
+
+void stop(void) {
+    const std::scoped_lock lock(control_mutex);
+    stop_locked();
+}
+
+void record(std::wstring_view source, const UFunction* func, const UObject* obj) {
+    if (!active.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    auto& buffer = get_thread_buffer();
+
+    auto session = current_session.load(std::memory_order_relaxed);
+    if (buffer.session != session) {
+        buffer.session = session;
+        buffer.seen_names.clear();
+    }
+
+    auto func_name = get_name_index(func->Name());
+    auto obj_name = get_name_index(obj->Name());
+    resolve_name(buffer, func, func_name);
+    resolve_name(buffer, obj, obj_name);
+
+    LARGE_INTEGER timestamp{};
+    QueryPerformanceCounter(&timestamp);
+
+    auto head = buffer.head.load(std::memory_order_relaxed);
+    if (head - buffer.tail.load(std::memory_order_acquire) >= BUFFER_SIZE) {
+        buffer.dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    buffer.records[head % BUFFER_SIZE] = {
+        .timestamp = static_cast<uint64_t>(timestamp.QuadPart),
+        .func = reinterpret_cast<uintptr_t>(func),
+        .obj = reinterpret_cast<uintptr_t>(obj),
+        .thread_id = buffer.thread_id,
+        .func_name = func_name,
+        .obj_name = obj_name,
+        .source = get_source_id(buffer, source),
+        .padding = {},
+    };
+    buffer.head.store(head + 1, std::memory_order_release);
+}
+
+}  // namespace unrealsdk::call_trace
+
+#endif
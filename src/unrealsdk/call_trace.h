@@ -0,0 +1,55 @@
+#ifndef UNREALSDK_CALL_TRACE_H
+#define UNREALSDK_CALL_TRACE_H
+
+#include "unrealsdk/pch.h"
+
+#ifndef UNREALSDK_IMPORTING
+
+namespace unrealsdk::unreal {
+
+class UObject;
+class UFunction;
+
+}  // namespace unrealsdk::unreal
+
+namespace unrealsdk::call_trace {
+
+/*
+The call trace is a compact binary log of every unreal function call, used to implement
+`hook_manager::log_all_calls`.
+
+Each calling thread writes fixed size records into it's own ring buffer, without taking any locks,
+which a background thread drains into the trace file. Names are only resolved the first time each
+object is seen, rather than on every call, and are written into the file separately.
+
+The trace can be turned back into a tsv using `tools/convert_call_trace.py`. The file format is
+documented there.
+*/
+
+/**
+ * @brief Starts tracing calls, truncating the given file. Restarts the trace if already running.
+ *
+ * @param path The path of the file to write the trace to.
+ */
+void start(const std::filesystem::path& path);
+
+/**
+ * @brief Stops tracing calls, flushing anything remaining to the file.
+ */
+void stop(void);
+
+/**
+ * @brief Records a single call in the trace.
+ * @note Should only be called while the trace is running - though if it isn't, this is a no-op.
+ *
+ * @param source The source of the call.
+ * @param func The function which was called.
+ * @param obj The object which called the function.
+ */
+void record(std::wstring_view source, const unreal::UFunction* func, const unreal::UObject* obj);
+
+}  // namespace unrealsdk::call_trace
+
+#endif
+
+#endif /* UNREALSDK_CALL_TRACE_H */
@@ -3,6 +3,7 @@
 
 #include "unrealsdk/hook_manager.h"
 #include "unrealsdk/memory.h"
+#include "unrealsdk/profiler.h"
 #include "unrealsdk/unreal/structs/fframe.h"
 #include "unrealsdk/version_error.h"
 
@@ -14,25 +15,30 @@ using namespace unrealsdk::unreal;
 namespace unrealsdk::game {
 
 void BL1Hook::hook(void) {
-    wait_for_steam_drm();
+    using profiler::impl::time_startup_phase;
 
-    hook_antidebug();
+    time_startup_phase("wait_for_steam_drm", [this]() { wait_for_steam_drm(); });
 
-    hook_process_event();
-    hook_call_function();
+    time_startup_phase("hook_antidebug", [this]() { hook_antidebug(); });
 
-    find_gobjects();
-    find_gnames();
-    find_fname_init();
-    find_fframe_step();
-    find_gmalloc();
-    find_construct_object();
-    find_get_path_name();
-    find_static_find_object();
-    find_load_package();
+    // Scan for everything at once, before any of our own patches get written
+    time_startup_phase("prescan", []() { PrescanEntry<BL1Hook>::prescan_all(); });
 
-    hexedit_set_command();
-    hexedit_array_limit();
+    time_startup_phase("hook_process_event", [this]() { hook_process_event(); });
+    time_startup_phase("hook_call_function", [this]() { hook_call_function(); });
+
+    time_startup_phase("find_gobjects", [this]() { find_gobjects(); });
+    time_startup_phase("find_gnames", [this]() { find_gnames(); });
+    time_startup_phase("find_fname_init", [this]() { find_fname_init(); });
+    time_startup_phase("find_fframe_step", [this]() { find_fframe_step(); });
+    time_startup_phase("find_gmalloc", [this]() { find_gmalloc(); });
+    time_startup_phase("find_construct_object", [this]() { find_construct_object(); });
+    time_startup_phase("find_get_path_name", [this]() { find_get_path_name(); });
+    time_startup_phase("find_static_find_object", [this]() { find_static_find_object(); });
+    time_startup_phase("find_load_package", [this]() { find_load_package(); });
+
+    time_startup_phase("hexedit_set_command", [this]() { hexedit_set_command(); });
+    time_startup_phase("hexedit_array_limit", [this]() { hexedit_array_limit(); });
 }
 
 void BL1Hook::post_init(void) {
@@ -52,8 +58,10 @@ namespace {
 const constinit Pattern<11> GNATIVES_SIG{
     "8B 14 95 {????????}"  // mov edx, [edx*4+01F942C0]
     "57"                   // push edi
-    "8D 4D ??"             // lea ecx, [ebp-44]
+    "8D 4D ??",            // lea ecx, [ebp-44]
+    SectionType::CODE,
 };
+const PrescanEntry<BL1Hook> GNATIVES_SIG_PRESCAN{GNATIVES_SIG};
 
 // NOLINTNEXTLINE(modernize-use-using)
 typedef void(__thiscall* fframe_step_func)(UObject*, FFrame*, void*);
@@ -107,6 +115,7 @@ const constinit Pattern<72> FNAME_INIT_SIG{
     "8B E9"              // mov ebp, ecx
     "89 6C 24 ??"        // mov [esp+1C], ebp
 };
+const PrescanEntry<BL1Hook> FNAME_INIT_SIG_PRESCAN{FNAME_INIT_SIG};
 
 // NOLINTNEXTLINE(modernize-use-using)
 typedef void(__thiscall* fname_init_func)(FName* name,
@@ -21,8 +21,10 @@ const constinit Pattern<18> GOBJECTS_SIG{
     "8B 04 ??"          // mov eax, [ecx+esi*4]
     "8B 50 ??"          // mov edx, [eax+0C]
     "21 58 ??"          // and [eax+08], ebx
-    "89 50 ??"          // mov [eax+0C], edx
+    "89 50 ??",         // mov [eax+0C], edx
+    SectionType::CODE,
 };
+const PrescanEntry<BL1Hook> GOBJECTS_SIG_PRESCAN{GOBJECTS_SIG};
 
 }  // namespace
 
@@ -45,8 +47,10 @@ const constinit Pattern<21> GNAMES_SIG{
     "68 ????????"    // push 00001000
     "6A ??"          // push 00
     "E8 ????????"    // call 005C21F0
-    "5E"             // pop esi
+    "5E",            // pop esi
+    SectionType::CODE,
 };
+const PrescanEntry<BL1Hook> GNAMES_SIG_PRESCAN{GNAMES_SIG};
 
 TArray<bl1::FNameEntry*>* gnames_ptr;
 
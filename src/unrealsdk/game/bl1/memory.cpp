@@ -37,8 +37,10 @@ FMalloc** gmalloc_ptr;
 
 const constinit Pattern<8> GMALLOC_PATTERN{
     "89 0D {????????}"  // mov [01F703F4],ecx { (05AA6980) }
-    "8B 11"             // mov edx,[ecx]
+    "8B 11",            // mov edx,[ecx]
+    SectionType::CODE,
 };
+const PrescanEntry<BL1Hook> GMALLOC_PATTERN_PRESCAN{GMALLOC_PATTERN};
 
 }  // namespace
 
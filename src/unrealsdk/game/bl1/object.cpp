@@ -45,6 +45,7 @@ const constinit Pattern<47> CONSTRUCT_OBJECT_PATTERN{
     "8B 6C 24 ??"     // mov ebp, [esp+54]
     "89 6C 24 ??"     // mov [esp+14], ebp
 };
+const PrescanEntry<BL1Hook> CONSTRUCT_OBJECT_PATTERN_PRESCAN{CONSTRUCT_OBJECT_PATTERN};
 
 }  // namespace
 
@@ -92,6 +93,7 @@ const constinit Pattern<13> GET_PATH_NAME_PATTERN{
     "74 ??"        // je 005D09D1
     "85 F6"        // test esi, esi
 };
+const PrescanEntry<BL1Hook> GET_PATH_NAME_PATTERN_PRESCAN{GET_PATH_NAME_PATTERN};
 
 }  // namespace
 
@@ -142,6 +144,7 @@ const constinit Pattern<47> STATIC_FIND_OBJECT_PATTERN{
     "8B 74 24 ??"     // mov esi, [esp+4C]
     "8B 7C 24 ??"     // mov edi, [esp+50]
 };
+const PrescanEntry<BL1Hook> STATIC_FIND_OBJECT_PATTERN_PRESCAN{STATIC_FIND_OBJECT_PATTERN};
 
 }  // namespace
 
@@ -173,6 +176,7 @@ const constinit Pattern<21> LOAD_PACKAGE_PATTERN{
     "83 EC 28"        // sub esp, 28
     "53"              // push ebx
 };
+const PrescanEntry<BL1Hook> LOAD_PACKAGE_PATTERN_PRESCAN{LOAD_PACKAGE_PATTERN};
 
 }  // namespace
 
@@ -1,6 +1,7 @@
 #include "unrealsdk/pch.h"
 #include "unrealsdk/game/bl1/bl1.h"
 #include "unrealsdk/memory.h"
+#include "unrealsdk/profiler.h"
 #include "unrealsdk/utils.h"
 
 #if UNREALSDK_FLAVOUR == UNREALSDK_FLAVOUR_WILLOW && !defined(UNREALSDK_IMPORTING)
@@ -86,8 +87,12 @@ void BL1Hook::wait_for_steam_drm(void) {
         // Drop out of this scope and unsuspend the other threads, let the unpacker run
     }
 
-    std::unique_lock lock(ready_mutex);
-    ready_cv.wait(lock, [] { return ready.load(); });
+    {
+        const profiler::impl::ScopedStartupPhase phase{"steam_drm_unpack"};
+
+        std::unique_lock lock(ready_mutex);
+        ready_cv.wait(lock, [] { return ready.load(); });
+    }
 
     MH_STATUS status = MH_OK;
     status = MH_DisableHook(reinterpret_cast<LPVOID>(&GetStartupInfoA));
@@ -2,6 +2,7 @@
 
 #include "unrealsdk/game/bl2/bl2.h"
 #include "unrealsdk/memory.h"
+#include "unrealsdk/profiler.h"
 #include "unrealsdk/unreal/classes/uobject.h"
 #include "unrealsdk/unreal/structs/fframe.h"
 #include "unrealsdk/unreal/structs/fname.h"
@@ -17,25 +18,30 @@ using namespace unrealsdk::unreal;
 namespace unrealsdk::game {
 
 void BL2Hook::hook(void) {
+    using profiler::impl::time_startup_phase;
+
     // Make sure to do antidebug asap
-    hook_antidebug();
-
-    hook_process_event();
-    hook_call_function();
-
-    find_gobjects();
-    find_gnames();
-    find_fname_init();
-    find_fframe_step();
-    find_gmalloc();
-    find_construct_object();
-    find_get_path_name();
-    find_static_find_object();
-    find_load_package();
-
-    hexedit_set_command();
-    hexedit_array_limit();
-    hexedit_array_limit_message();
+    time_startup_phase("hook_antidebug", [this]() { hook_antidebug(); });
+
+    // Scan for everything at once, before any of our own patches get written
+    time_startup_phase("prescan", []() { PrescanEntry<BL2Hook>::prescan_all(); });
+
+    time_startup_phase("hook_process_event", [this]() { hook_process_event(); });
+    time_startup_phase("hook_call_function", [this]() { hook_call_function(); });
+
+    time_startup_phase("find_gobjects", [this]() { find_gobjects(); });
+    time_startup_phase("find_gnames", [this]() { find_gnames(); });
+    time_startup_phase("find_fname_init", [this]() { find_fname_init(); });
+    time_startup_phase("find_fframe_step", [this]() { find_fframe_step(); });
+    time_startup_phase("find_gmalloc", [this]() { find_gmalloc(); });
+    time_startup_phase("find_construct_object", [this]() { find_construct_object(); });
+    time_startup_phase("find_get_path_name", [this]() { find_get_path_name(); });
+    time_startup_phase("find_static_find_object", [this]() { find_static_find_object(); });
+    time_startup_phase("find_load_package", [this]() { find_load_package(); });
+
+    time_startup_phase("hexedit_set_command", [this]() { hexedit_set_command(); });
+    time_startup_phase("hexedit_array_limit", [this]() { hexedit_array_limit(); });
+    time_startup_phase("hexedit_array_limit_message", [this]() { hexedit_array_limit_message(); });
 }
 
 void BL2Hook::post_init(void) {
@@ -60,6 +66,7 @@ const constinit Pattern<23> FNAME_INIT_SIG{
     "50"              // push eax
     "81 EC 9C0C0000"  // sub esp, 00000C9C
 };
+const PrescanEntry<BL2Hook> FNAME_INIT_SIG_PRESCAN{FNAME_INIT_SIG};
 
 }
 
@@ -92,6 +99,7 @@ const constinit Pattern<9> FFRAME_STEP_SIG{
     "8B 41 ??"  // mov eax, [ecx+18]
     "0FB6 10"   // movzx edx, byte ptr [eax]
 };
+const PrescanEntry<BL2Hook> FFRAME_STEP_SIG_PRESCAN{FFRAME_STEP_SIG};
 
 }  // namespace
 
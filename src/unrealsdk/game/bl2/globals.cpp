@@ -21,8 +21,10 @@ const constinit Pattern<17> GOBJECTS_SIG{
     "8B 0D {????????}"  // mov ecx, [Borderlands2.exe+1682BD0]
     "8B 04 ??"          // mov eax, [ecx+esi*4]
     "8B 40 ??"          // mov eax, [eax+08]
-    "25 00020000"       // and eax, 00000200
+    "25 00020000",      // and eax, 00000200
+    SectionType::CODE,
 };
+const PrescanEntry<BL2Hook> GOBJECTS_SIG_PRESCAN{GOBJECTS_SIG};
 
 }  // namespace
 
@@ -42,8 +44,10 @@ namespace {
 const constinit Pattern<10> GNAMES_SIG{
     "A3 {????????}"  // mov [BorderlandsPreSequel.exe+1520214], eax
     "8B 45 ??"       // mov eax, [ebp+10]
-    "89 03"          // mov [ebx], eax
+    "89 03",         // mov [ebx], eax
+    SectionType::CODE,
 };
+const PrescanEntry<BL2Hook> GNAMES_SIG_PRESCAN{GNAMES_SIG};
 TArray<bl2::FNameEntry*>* gnames_ptr;
 
 }  // namespace
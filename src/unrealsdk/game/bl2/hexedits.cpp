@@ -22,12 +22,14 @@ const constinit Pattern<28> SET_COMMAND_SIG{
     "85 C0"           // test eax, eax
     "74 ??"           // je Borderlands2.exe+4301C6
 };
+const PrescanEntry<BL2Hook> SET_COMMAND_SIG_PRESCAN{SET_COMMAND_SIG};
 
 const constinit Pattern<9> ARRAY_LIMIT_SIG{
     "7E ??"        // jle Borderlands2.exe+C9ABB
     "B9 64000000"  // mov ecx, 00000064
     "3B F9"        // cmp edi, ecx
 };
+const PrescanEntry<BL2Hook> ARRAY_LIMIT_SIG_PRESCAN{ARRAY_LIMIT_SIG};
 
 const constinit Pattern<15> ARRAY_LIMIT_MESSAGE{
     // Explicitly match the jump offset, since to overwrite this with an unconditional jump we need
@@ -36,6 +38,7 @@ const constinit Pattern<15> ARRAY_LIMIT_MESSAGE{
     "8B 8D ????????"  // mov ecx, [ebp-00001164]
     "83 C0 9D"        // add eax, -63
 };
+const PrescanEntry<BL2Hook> ARRAY_LIMIT_MESSAGE_PRESCAN{ARRAY_LIMIT_MESSAGE};
 
 }  // namespace
 
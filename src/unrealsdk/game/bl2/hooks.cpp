@@ -5,6 +5,7 @@
 #include "unrealsdk/hook_manager.h"
 #include "unrealsdk/locks.h"
 #include "unrealsdk/memory.h"
+#include "unrealsdk/profiler.h"
 #include "unrealsdk/unreal/classes/ufunction.h"
 #include "unrealsdk/unreal/classes/uobject.h"
 #include "unrealsdk/unreal/classes/uproperty.h"
@@ -54,12 +55,15 @@ const constinit Pattern<45> PROCESS_EVENT_SIG{
     "64 A3 ????????"  // mov fs:[00000000], eax
     "8B F1"           // mov esi, ecx
 };
+const PrescanEntry<BL2Hook> PROCESS_EVENT_SIG_PRESCAN{PROCESS_EVENT_SIG};
 
 void __fastcall process_event_hook(UObject* obj,
                                    void* edx,
                                    UFunction* func,
                                    void* params,
                                    void* null) {
+    const profiler::impl::ScopedCall profile{func};
+
     try {
         // This arg seems to be in the process of being deprecated, no usage in ghidra, always seems
         // to be null, and it's gone in later ue versions. Gathering some extra info just in case.
@@ -68,11 +72,13 @@ void __fastcall process_event_hook(UObject* obj,
                 func->get_path_name(), obj->get_path_name());
         }
 
-        auto data = hook_manager::impl::preprocess_hook(L"ProcessEvent", func, obj);
+        auto data =
+            hook_manager::impl::preprocess_hook(hook_manager::Source::PROCESS_EVENT, func, obj);
         if (data != nullptr) {
-            // Copy args so that hooks can't modify them, for parity with call function
+            // Hooks get a view of the args, which gets copied the first time they try to modify it,
+            // so that they can't modify the real args, for parity with call function
             const WrappedStruct args_base{func, params};
-            WrappedStruct args = args_base.copy_params_only();
+            WrappedStruct args = args_base.copy_params_on_write();
             hook_manager::Details hook{.obj = obj,
                                        .args = &args,
                                        .ret = {func->find_return_param()},
@@ -81,6 +87,11 @@ void __fastcall process_event_hook(UObject* obj,
             const bool block_execution =
                 hook_manager::impl::run_hooks_of_type(data, hook_manager::Type::PRE, hook);
 
+            if (hook_manager::impl::has_post_hooks(data)) {
+                // The call may overwrite the params, copy them now so post hooks see the same args
+                args.materialize();
+            }
+
             if (!block_execution) {
                 process_event_ptr(obj, edx, func, params, null);
             }
@@ -129,11 +140,14 @@ static_assert(std::is_same_v<decltype(&process_event_hook), decltype(&locking_pr
 }  // namespace
 
 void BL2Hook::hook_process_event(void) {
-    detour(PROCESS_EVENT_SIG,
-           // If we don't need locks, it's slightly more efficient to detour directly to the
-           // non-locking version
-           locks::FunctionCall::enabled() ? locking_process_event_hook : process_event_hook,
-           &process_event_ptr, "ProcessEvent");
+    auto addr = PROCESS_EVENT_SIG.sigscan_nullable();
+    if (detour(addr,
+               // If we don't need locks, it's slightly more efficient to detour directly to the
+               // non-locking version
+               locks::FunctionCall::enabled() ? locking_process_event_hook : process_event_hook,
+               &process_event_ptr, "ProcessEvent")) {
+        hook_manager::impl::register_hook_detour(addr);
+    }
 }
 
 void BL2Hook::process_event(UObject* object, UFunction* func, void* params) const {
@@ -173,14 +187,18 @@ const constinit Pattern<55> CALL_FUNCTION_SIG{
     "8B 45 ??"        // mov eax, [ebp+14]
     "8B 5D ??"        // mov ebx, [ebp+0C]
 };
+const PrescanEntry<BL2Hook> CALL_FUNCTION_SIG_PRESCAN{CALL_FUNCTION_SIG};
 
 void __fastcall call_function_hook(UObject* obj,
                                    void* edx,
                                    FFrame* stack,
                                    void* result,
                                    UFunction* func) {
+    const profiler::impl::ScopedCall profile{func};
+
     try {
-        auto data = hook_manager::impl::preprocess_hook(L"CallFunction", func, obj);
+        auto data =
+            hook_manager::impl::preprocess_hook(hook_manager::Source::CALL_FUNCTION, func, obj);
         if (data != nullptr) {
             WrappedStruct args{func};
             auto original_code = stack->extract_current_args(args);
@@ -248,9 +266,12 @@ static_assert(std::is_same_v<decltype(&locking_call_function_hook), call_functio
 }  // namespace
 
 void BL2Hook::hook_call_function(void) {
-    detour(CALL_FUNCTION_SIG,
-           locks::FunctionCall::enabled() ? locking_call_function_hook : call_function_hook,
-           &call_function_ptr, "CallFunction");
+    auto addr = CALL_FUNCTION_SIG.sigscan_nullable();
+    if (detour(addr,
+               locks::FunctionCall::enabled() ? locking_call_function_hook : call_function_hook,
+               &call_function_ptr, "CallFunction")) {
+        hook_manager::impl::register_hook_detour(addr);
+    }
 }
 
 }  // namespace unrealsdk::game
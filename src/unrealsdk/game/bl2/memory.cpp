@@ -37,8 +37,10 @@ FMalloc* gmalloc;
 
 const constinit Pattern<8> GMALLOC_PATTERN{
     "89 35 {????????}"  // mov [Borderlands2.GDebugger+A95C], esi
-    "FF D7"             // call edi
+    "FF D7",            // call edi
+    SectionType::CODE,
 };
+const PrescanEntry<BL2Hook> GMALLOC_PATTERN_PRESCAN{GMALLOC_PATTERN};
 
 }  // namespace
 
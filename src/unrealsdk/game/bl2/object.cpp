@@ -52,6 +52,7 @@ const constinit Pattern<49> CONSTRUCT_OBJECT_PATTERN{
     "8B 7D ??"        // mov edi, [ebp+08]
     "8A 87 ????????"  // mov al, [edi+000001CC]
 };
+const PrescanEntry<BL2Hook> CONSTRUCT_OBJECT_PATTERN_PRESCAN{CONSTRUCT_OBJECT_PATTERN};
 
 }  // namespace
 
@@ -106,6 +107,7 @@ const constinit Pattern<15> GET_PATH_NAME_PATTERN{
     "74 ??"     // je Borderlands2.exe+ADB04
     "85 F6"     // test esi, esi
 };
+const PrescanEntry<BL2Hook> GET_PATH_NAME_PATTERN_PRESCAN{GET_PATH_NAME_PATTERN};
 
 }  // namespace
 
@@ -161,6 +163,7 @@ const constinit Pattern<56> STATIC_FIND_OBJECT_PATTERN{
     "75 ??"              // jne Borderlands2.GetOutermost+429A
     "83 3D ???????? 00"  // cmp dword ptr [Borderlands2.exe+15E801C], 00
 };
+const PrescanEntry<BL2Hook> STATIC_FIND_OBJECT_PATTERN_PRESCAN{STATIC_FIND_OBJECT_PATTERN};
 
 }  // namespace
 
@@ -201,6 +204,7 @@ const constinit Pattern<46> LOAD_PACKAGE_PATTERN{
     "64 A3 ????????"  // mov fs:[00000000], eax
     "89 65 ??"        // mov [ebp-10], esp
 };
+const PrescanEntry<BL2Hook> LOAD_PACKAGE_PATTERN_PRESCAN{LOAD_PACKAGE_PATTERN};
 
 }  // namespace
 
@@ -1,6 +1,7 @@
 #include "unrealsdk/pch.h"
 #include "unrealsdk/game/bl3/bl3.h"
 #include "unrealsdk/memory.h"
+#include "unrealsdk/profiler.h"
 #include "unrealsdk/unreal/classes/uobject.h"
 #include "unrealsdk/unreal/structs/fframe.h"
 #include "unrealsdk/unreal/structs/fname.h"
@@ -15,20 +16,26 @@ using namespace unrealsdk::memory;
 namespace unrealsdk::game {
 
 void BL3Hook::hook(void) {
-    hook_process_event();
-    hook_call_function();
-
-    find_gobjects();
-    find_gnames();
-    find_fname_init();
-    find_fframe_step();
-    find_gmalloc();
-    find_construct_object();
-    find_get_path_name();
-    find_static_find_object();
-    find_ftext_as_culture_invariant();
-    find_load_package();
-    find_persistent_obj_ptrs();
+    using profiler::impl::time_startup_phase;
+
+    // Scan for everything at once, before any of our own patches get written
+    time_startup_phase("prescan", []() { PrescanEntry<BL3Hook>::prescan_all(); });
+
+    time_startup_phase("hook_process_event", [this]() { hook_process_event(); });
+    time_startup_phase("hook_call_function", [this]() { hook_call_function(); });
+
+    time_startup_phase("find_gobjects", [this]() { find_gobjects(); });
+    time_startup_phase("find_gnames", [this]() { find_gnames(); });
+    time_startup_phase("find_fname_init", [this]() { find_fname_init(); });
+    time_startup_phase("find_fframe_step", [this]() { find_fframe_step(); });
+    time_startup_phase("find_gmalloc", [this]() { find_gmalloc(); });
+    time_startup_phase("find_construct_object", [this]() { find_construct_object(); });
+    time_startup_phase("find_get_path_name", [this]() { find_get_path_name(); });
+    time_startup_phase("find_static_find_object", [this]() { find_static_find_object(); });
+    time_startup_phase("find_ftext_as_culture_invariant",
+                       [this]() { find_ftext_as_culture_invariant(); });
+    time_startup_phase("find_load_package", [this]() { find_load_package(); });
+    time_startup_phase("find_persistent_obj_ptrs", [this]() { find_persistent_obj_ptrs(); });
 }
 
 void BL3Hook::post_init(void) {
@@ -54,6 +61,7 @@ const constinit Pattern<15> FNAME_INIT_PATTERN{
     "57"                 // push rdi
     "48 81 EC 60080000"  // sub rsp, 00000860
 };
+const PrescanEntry<BL3Hook> FNAME_INIT_PATTERN_PRESCAN{FNAME_INIT_PATTERN};
 
 }  // namespace
 
@@ -80,6 +88,7 @@ const constinit Pattern<10> FFRAME_STEP_SIG{
     "4C 8B D2"     // mov r10, rdx
     "48 8B D1"     // mov rdx, rcx
 };
+const PrescanEntry<BL3Hook> FFRAME_STEP_SIG_PRESCAN{FFRAME_STEP_SIG};
 
 }  // namespace
 
@@ -141,6 +150,8 @@ const constinit Pattern<131> FTEXT_AS_CULTURE_INVARIANT_PATTERN{
     "5F"              // pop rdi
     "C3"              // ret
 };
+const PrescanEntry<BL3Hook> FTEXT_AS_CULTURE_INVARIANT_PATTERN_PRESCAN{
+    FTEXT_AS_CULTURE_INVARIANT_PATTERN};
 
 }  // namespace
 
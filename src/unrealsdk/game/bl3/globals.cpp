@@ -21,8 +21,10 @@ const constinit Pattern<26> GOBJECTS_SIG{
     "48 8D 0D {????????}"  // lea rcx, [Borderlands3.exe+69EBDA0]
     "C6 05 ???????? 01"    // mov byte ptr [Borderlands3.exe+69EA290], 01
     "E8 ????????"          // call Borderlands3.exe+17854D0
-    "C6 05 ???????? 01"    // mov byte ptr [Borderlands3.exe+64B78E0], 01
+    "C6 05 ???????? 01",   // mov byte ptr [Borderlands3.exe+64B78E0], 01
+    SectionType::CODE,
 };
+const PrescanEntry<BL3Hook> GOBJECTS_SIG_PRESCAN{GOBJECTS_SIG};
 
 }  // namespace
 
@@ -46,8 +48,10 @@ const constinit Pattern<27> GNAMES_SIG{
     "48 8B 5C 24 ??"       // mov rbx, [rsp+20]
     "48 83 C4 28"          // add rsp, 28
     "C3"                   // ret
-    "33 DB"                // xor ebx, ebx
+    "33 DB",               // xor ebx, ebx
+    SectionType::CODE,
 };
+const PrescanEntry<BL3Hook> GNAMES_SIG_PRESCAN{GNAMES_SIG};
 TStaticIndirectArrayThreadSafeRead_FNameEntry* gnames_ptr;
 
 }  // namespace
@@ -5,6 +5,7 @@
 #include "unrealsdk/hook_manager.h"
 #include "unrealsdk/locks.h"
 #include "unrealsdk/memory.h"
+#include "unrealsdk/profiler.h"
 #include "unrealsdk/unreal/classes/ufunction.h"
 #include "unrealsdk/unreal/classes/uobject.h"
 #include "unrealsdk/unreal/structs/fframe.h"
@@ -34,14 +35,19 @@ const constinit Pattern<19> PROCESS_EVENT_SIG{
     "41 57"              // push r15
     "48 81 EC F0000000"  // sub rsp, 000000F0
 };
+const PrescanEntry<BL3Hook> PROCESS_EVENT_SIG_PRESCAN{PROCESS_EVENT_SIG};
 
 void process_event_hook(UObject* obj, UFunction* func, void* params) {
+    const profiler::impl::ScopedCall profile{func};
+
     try {
-        auto data = hook_manager::impl::preprocess_hook(L"ProcessEvent", func, obj);
+        auto data =
+            hook_manager::impl::preprocess_hook(hook_manager::Source::PROCESS_EVENT, func, obj);
         if (data != nullptr) {
-            // Copy args so that hooks can't modify them, for parity with call function
+            // Hooks get a view of the args, which gets copied the first time they try to modify it,
+            // so that they can't modify the real args, for parity with call function
             const WrappedStruct args_base{func, params};
-            WrappedStruct args = args_base.copy_params_only();
+            WrappedStruct args = args_base.copy_params_on_write();
             hook_manager::Details hook{.obj = obj,
                                        .args = &args,
                                        .ret = {func->find_return_param()},
@@ -50,6 +56,11 @@ void process_event_hook(UObject* obj, UFunction* func, void* params) {
             const bool block_execution =
                 hook_manager::impl::run_hooks_of_type(data, hook_manager::Type::PRE, hook);
 
+            if (hook_manager::impl::has_post_hooks(data)) {
+                // The call may overwrite the params, copy them now so post hooks see the same args
+                args.materialize();
+            }
+
             if (!block_execution) {
                 process_event_ptr(obj, func, params);
             }
@@ -95,11 +106,14 @@ static_assert(std::is_same_v<decltype(process_event_hook), decltype(locking_proc
 }  // namespace
 
 void BL3Hook::hook_process_event(void) {
-    detour(PROCESS_EVENT_SIG,
-           // If we don't need locks, it's slightly more efficient to detour directly to the
-           // non-locking version
-           locks::FunctionCall::enabled() ? locking_process_event_hook : process_event_hook,
-           &process_event_ptr, "ProcessEvent");
+    auto addr = PROCESS_EVENT_SIG.sigscan_nullable();
+    if (detour(addr,
+               // If we don't need locks, it's slightly more efficient to detour directly to the
+               // non-locking version
+               locks::FunctionCall::enabled() ? locking_process_event_hook : process_event_hook,
+               &process_event_ptr, "ProcessEvent")) {
+        hook_manager::impl::register_hook_detour(addr);
+    }
 }
 
 void BL3Hook::process_event(UObject* object, UFunction* func, void* params) const {
@@ -124,8 +138,11 @@ const constinit Pattern<20> CALL_FUNCTION_SIG{
     "41 57"              // push r15
     "48 81 EC 28010000"  // sub rsp, 00000128
 };
+const PrescanEntry<BL3Hook> CALL_FUNCTION_SIG_PRESCAN{CALL_FUNCTION_SIG};
 
 void call_function_hook(UObject* obj, FFrame* stack, void* result, UFunction* func) {
+    const profiler::impl::ScopedCall profile{func};
+
     try {
         /*
         NOTE: The early exit here also avoids access violations for a few special functions, e.g.:
@@ -150,7 +167,8 @@ void call_function_hook(UObject* obj, FFrame* stack, void* result, UFunction* fu
         implementation simpler.
         */
 
-        auto data = hook_manager::impl::preprocess_hook(L"CallFunction", func, obj);
+        auto data =
+            hook_manager::impl::preprocess_hook(hook_manager::Source::CALL_FUNCTION, func, obj);
         if (data != nullptr) {
             WrappedStruct args{func};
             auto original_code = stack->extract_current_args(args);
@@ -214,9 +232,12 @@ static_assert(std::is_same_v<decltype(locking_call_function_hook), call_function
 }  // namespace
 
 void BL3Hook::hook_call_function(void) {
-    detour(CALL_FUNCTION_SIG,
-           locks::FunctionCall::enabled() ? locking_call_function_hook : call_function_hook,
-           &call_function_ptr, "CallFunction");
+    auto addr = CALL_FUNCTION_SIG.sigscan_nullable();
+    if (detour(addr,
+               locks::FunctionCall::enabled() ? locking_call_function_hook : call_function_hook,
+               &call_function_ptr, "CallFunction")) {
+        hook_manager::impl::register_hook_detour(addr);
+    }
 }
 
 }  // namespace unrealsdk::game
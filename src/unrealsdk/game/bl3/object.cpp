@@ -44,6 +44,7 @@ const constinit Pattern<55> CONSTRUCT_OBJECT_PATTERN{
     "48 89 85 ????????"     // mov [rbp+000000B0], rax
     "44 8B A5 ????????"     // mov r12d, [rbp+00000120]
 };
+const PrescanEntry<BL3Hook> CONSTRUCT_OBJECT_PATTERN_PRESCAN{CONSTRUCT_OBJECT_PATTERN};
 
 }  // namespace
 
@@ -83,6 +84,7 @@ const constinit Pattern<21> GET_PATH_NAME_PATTERN{
     "49 8B F8"        // mov rdi, r8
     "48 8B E9"        // mov rbp, rcx
 };
+const PrescanEntry<BL3Hook> GET_PATH_NAME_PATTERN_PRESCAN{GET_PATH_NAME_PATTERN};
 
 }  // namespace
 
@@ -122,6 +124,7 @@ const constinit Pattern<27> STATIC_FIND_OBJECT_PATTERN{
     "48 83 EC 30"        // sub rsp, 30
     "80 3D ???????? 00"  // cmp byte ptr [Borderlands3.exe+69EAA10], 00
 };
+const PrescanEntry<BL3Hook> STATIC_FIND_OBJECT_PATTERN_PRESCAN{STATIC_FIND_OBJECT_PATTERN};
 
 const constexpr intptr_t ANY_PACKAGE = -1;
 
@@ -157,6 +160,7 @@ const constinit Pattern<16> LOAD_PACKAGE_PATTERN{
     "48 89 68 ??"  // mov [rax+08], rbp
     "48 8B EA"     // mov rbp, rdx
 };
+const PrescanEntry<BL3Hook> LOAD_PACKAGE_PATTERN_PRESCAN{LOAD_PACKAGE_PATTERN};
 
 }  // namespace
 
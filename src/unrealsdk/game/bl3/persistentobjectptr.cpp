@@ -50,6 +50,7 @@ const constinit Pattern<43> SET_SOFT_OBJ_PTR_PATTERN{
     "F0 0FB1 1D ????????"  // lock cmpxchg [FSoftObjectPath::CurrentTag], ebx
     "48 8B 4D ??"          // mov rcx, [rbp-20]
 };
+const PrescanEntry<BL3Hook> SET_SOFT_OBJ_PTR_PATTERN_PRESCAN{SET_SOFT_OBJ_PTR_PATTERN};
 
 const constexpr auto SOFT_OBJ_PATH_CONSTRUCTOR_OFFSET = 1;
 const constexpr auto SOFT_OBJ_PATH_CURRENT_TAG_OFFSET = 35;
@@ -70,6 +71,7 @@ const constinit Pattern<36> SET_LAZY_OBJ_PTR_PATTERN{
     "33 C0"                // xor eax, eax
     "F0 0FB1 1D ????????"  // lock cmpxchg [FLazyObjectPath::CurrentTag], ebx
 };
+const PrescanEntry<BL3Hook> SET_LAZY_OBJ_PTR_PATTERN_PRESCAN{SET_LAZY_OBJ_PTR_PATTERN};
 
 const constexpr auto LAZY_OBJ_PATH_CONSTRUCTOR_OFFSET = 1;
 const constexpr auto LAZY_OBJ_PATH_CURRENT_TAG_OFFSET = 32;
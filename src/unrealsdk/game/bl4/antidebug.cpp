@@ -2,6 +2,7 @@
 #include "unrealsdk/config.h"
 #include "unrealsdk/game/bl4/bl4.h"
 #include "unrealsdk/memory.h"
+#include "unrealsdk/profiler.h"
 
 #if UNREALSDK_FLAVOUR == UNREALSDK_FLAVOUR_OAK2 && !defined(UNREALSDK_IMPORTING)
 
@@ -81,11 +82,13 @@ void restore_antidebugd_functions(void) {
     }
 }
 
+// This lives in the protector's own code, which we can't rely on being in a section marked as such
 const constexpr Pattern<13> SYMBIOTE_ENTRY_POINT_PATTERN{
-    "E8 ????????"  // call 168C5A9D9
-    "55"           // push rbp
-    "48 8B EC"     // mov rbp, rsp
-    "48 83 E4 F0"  // and rsp, -10
+    "E8 ????????"   // call 168C5A9D9
+    "55"            // push rbp
+    "48 8B EC"      // mov rbp, rsp
+    "48 83 E4 F0",  // and rsp, -10
+    SectionType::ANY,
 };
 
 [[noreturn]] void symbiote_hook(void) {
@@ -123,9 +126,12 @@ void BL4Hook::hook_antidebug(void) {
 
     if (unrealsdk::config::get_bool("unrealsdk.bl4_debug.wait_for_debugger").value_or(false)) {
         LOG(DEV_WARNING, "Waiting for debugger to attach");
-        while (IsDebuggerPresent() == 0) {
-            // NOLINTNEXTLINE(readability-magic-numbers)
-            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        {
+            const profiler::impl::ScopedStartupPhase phase{"wait_for_debugger"};
+            while (IsDebuggerPresent() == 0) {
+                // NOLINTNEXTLINE(readability-magic-numbers)
+                std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            }
         }
         LOG(DEV_WARNING, "Got debugger");
 
@@ -1,6 +1,7 @@
 #include "unrealsdk/pch.h"
 #include "unrealsdk/game/bl4/bl4.h"
 #include "unrealsdk/memory.h"
+#include "unrealsdk/profiler.h"
 #include "unrealsdk/unreal/classes/uobject.h"
 #include "unrealsdk/unreal/structs/fframe.h"
 #include "unrealsdk/unreal/structs/fname.h"
@@ -14,20 +15,27 @@ using namespace unrealsdk::memory;
 
 namespace unrealsdk::game {
 void BL4Hook::hook(void) {
-    hook_antidebug();
-    hook_call_function();
-    hook_process_event();
-
-    find_fname_funcs();
-    find_gobjects();
-    find_gmalloc();
-    find_get_path_name();
-
-    find_construct_object();
-    find_static_find_object();
-    find_load_package();
-    find_fframe_step();
-    find_ftext_as_culture_invariant();
+    using profiler::impl::time_startup_phase;
+
+    time_startup_phase("hook_antidebug", [this]() { hook_antidebug(); });
+
+    // Scan for everything at once, before any of our own patches get written
+    time_startup_phase("prescan", []() { PrescanEntry<BL4Hook>::prescan_all(); });
+
+    time_startup_phase("hook_call_function", [this]() { hook_call_function(); });
+    time_startup_phase("hook_process_event", [this]() { hook_process_event(); });
+
+    time_startup_phase("find_fname_funcs", [this]() { find_fname_funcs(); });
+    time_startup_phase("find_gobjects", [this]() { find_gobjects(); });
+    time_startup_phase("find_gmalloc", [this]() { find_gmalloc(); });
+    time_startup_phase("find_get_path_name", [this]() { find_get_path_name(); });
+
+    time_startup_phase("find_construct_object", [this]() { find_construct_object(); });
+    time_startup_phase("find_static_find_object", [this]() { find_static_find_object(); });
+    time_startup_phase("find_load_package", [this]() { find_load_package(); });
+    time_startup_phase("find_fframe_step", [this]() { find_fframe_step(); });
+    time_startup_phase("find_ftext_as_culture_invariant",
+                       [this]() { find_ftext_as_culture_invariant(); });
 }
 
 void BL4Hook::post_init(void) {
@@ -46,8 +54,10 @@ const constinit Pattern<19> GNATIVES_PTR{
     "4C 8D 0D {????????}"  // lea r9, [Borderlands4.exe+C5CBDB0]
     "41 FF 14 C1"          // call qword ptr [r9+rax*8]
     "48 83 C4 ??"          // add rsp, 20
-    "80 7D F8 01"          // cmp byte ptr [rbp-08], 01
+    "80 7D F8 01",         // cmp byte ptr [rbp-08], 01
+    SectionType::CODE,
 };
+const PrescanEntry<BL4Hook> GNATIVES_PTR_PRESCAN{GNATIVES_PTR};
 
 }  // namespace
 
@@ -92,6 +102,8 @@ const constinit Pattern<50> FTEXT_AS_CULTURE_INVARIANT_PATTERN{
     "C3"           // ret
     "E8 ????????"  // call Borderlands4.exe+14554C72A
 };
+const PrescanEntry<BL4Hook> FTEXT_AS_CULTURE_INVARIANT_PATTERN_PRESCAN{
+    FTEXT_AS_CULTURE_INVARIANT_PATTERN};
 
 }  // namespace
 
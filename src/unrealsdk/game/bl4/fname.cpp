@@ -2,6 +2,7 @@
 #include "unrealsdk/game/bl4/bl4.h"
 #include "unrealsdk/game/bl4/offsets.h"
 #include "unrealsdk/memory.h"
+#include "unrealsdk/profiler.h"
 #include "unrealsdk/unreal/structs/gnames.h"
 #include "unrealsdk/utils.h"
 
@@ -19,8 +20,10 @@ const constexpr Pattern<24> FNAMEPOOL_SIG{
     "48 8D 0D ????????"  // lea rcx, [Borderlands4.exe+C4E7C40]          <--- FNamePool
     "E8 ????????"        // call Borderlands4.exe+3172E                  <--- Init func
     "C6 05 ???????? 01"  // mov byte ptr [Borderlands4.exe+C4E7C08], 01  <--- Initialized flag
-    "83 FF 01"           // cmp edi, 01
+    "83 FF 01",          // cmp edi, 01
+    SectionType::CODE,
 };
+const PrescanEntry<BL4Hook> FNAMEPOOL_SIG_PRESCAN{FNAMEPOOL_SIG};
 const constexpr auto FNAMEPOOL_PTR_OFFSET = 5;
 const constexpr auto FNAMEPOOL_INITIALIZED_OFFSET = 16;
 
@@ -37,6 +40,7 @@ const constexpr Pattern<35> FNAME_FIND_OR_STORE_WSTRING{
     "48 89 84 24 ????????"  // mov [rsp+00000438], rax
     "48 63 42 08"           // movsxd  rax, dword ptr [rdx+08]
 };
+const PrescanEntry<BL4Hook> FNAME_FIND_OR_STORE_WSTRING_PRESCAN{FNAME_FIND_OR_STORE_WSTRING};
 
 struct FNameStringView {
     const wchar_t* str;
@@ -60,9 +64,12 @@ void BL4Hook::find_fname_funcs(void) {
     // Just wait for it to happen on the main thread instead
     auto name_pool_initialized =
         read_offset<volatile uint8_t*>(name_pool_base + FNAMEPOOL_INITIALIZED_OFFSET);
-    while (*name_pool_initialized != 0) {
-        const constexpr auto sleep_time = std::chrono::milliseconds{50};
-        std::this_thread::sleep_for(sleep_time);
+    {
+        const profiler::impl::ScopedStartupPhase phase{"wait_for_fname_pool"};
+        while (*name_pool_initialized != 0) {
+            const constexpr auto sleep_time = std::chrono::milliseconds{50};
+            std::this_thread::sleep_for(sleep_time);
+        }
     }
 
     fname_find_or_store_wstring_ptr =
@@ -2,6 +2,7 @@
 #include "unrealsdk/unreal/wrappers/gobjects.h"
 #include "unrealsdk/game/bl4/bl4.h"
 #include "unrealsdk/memory.h"
+#include "unrealsdk/profiler.h"
 
 #if UNREALSDK_FLAVOUR == UNREALSDK_FLAVOUR_OAK2 && !defined(UNREALSDK_IMPORTING)
 
@@ -15,8 +16,10 @@ namespace {
 const constexpr Pattern<15> GOBJECTS_SIG{
     "44 8B 05 {????????}"  // mov r8d, [Borderlands4.exe+C5CD8F8]
     "8B 15 ????????"       // mov edx, [Borderlands4.exe+C5CD91C]
-    "89 F9"                // mov ecx, edi
+    "89 F9",               // mov ecx, edi
+    SectionType::CODE,
 };
+const PrescanEntry<BL4Hook> GOBJECTS_SIG_PRESCAN{GOBJECTS_SIG};
 
 GObjects gobjects_wrapper{};
 
@@ -29,9 +32,12 @@ void BL4Hook::find_gobjects(void) {
     gobjects_wrapper = GObjects(gobjects_ptr);
 
     // wait for gobjects to be initialized
-    while (gobjects_ptr->ObjObjects.Count == 0) {
-        const constexpr auto sleep_time = std::chrono::milliseconds{50};
-        std::this_thread::sleep_for(sleep_time);
+    {
+        const profiler::impl::ScopedStartupPhase phase{"wait_for_gobjects"};
+        while (gobjects_ptr->ObjObjects.Count == 0) {
+            const constexpr auto sleep_time = std::chrono::milliseconds{50};
+            std::this_thread::sleep_for(sleep_time);
+        }
     }
 
     LOG(MISC, "GObjObjects at {}", gobjects_ptr->ObjObjects.Count);
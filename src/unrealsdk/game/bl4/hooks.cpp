@@ -3,6 +3,7 @@
 #include "unrealsdk/hook_manager.h"
 #include "unrealsdk/locks.h"
 #include "unrealsdk/memory.h"
+#include "unrealsdk/profiler.h"
 #include "unrealsdk/unreal/structs/fframe.h"
 
 #if UNREALSDK_FLAVOUR == UNREALSDK_FLAVOUR_OAK2 && !defined(UNREALSDK_IMPORTING)
@@ -33,10 +34,14 @@ const constinit Pattern<27> CALL_FUNCTION_SIG{
     "4C 89 CE"        // mov rsi, r9
     "4D 89 C6"        // mov r14, r8
 };
+const PrescanEntry<BL4Hook> CALL_FUNCTION_SIG_PRESCAN{CALL_FUNCTION_SIG};
 
 void call_function_hook(UObject* obj, FFrame* stack, void* result, UFunction* func) {
+    const profiler::impl::ScopedCall profile{func};
+
     try {
-        auto data = hook_manager::impl::preprocess_hook(L"CallFunction", func, obj);
+        auto data =
+            hook_manager::impl::preprocess_hook(hook_manager::Source::CALL_FUNCTION, func, obj);
         if (data != nullptr) {
             WrappedStruct args{func};
             auto original_code = stack->extract_current_args(args);
@@ -100,9 +105,12 @@ static_assert(std::is_same_v<decltype(locking_call_function_hook), call_function
 }  // namespace
 
 void BL4Hook::hook_call_function(void) {
-    detour(CALL_FUNCTION_SIG,
-           locks::FunctionCall::enabled() ? locking_call_function_hook : call_function_hook,
-           &call_function_ptr, "CallFunction");
+    auto addr = CALL_FUNCTION_SIG.sigscan_nullable();
+    if (detour(addr,
+               locks::FunctionCall::enabled() ? locking_call_function_hook : call_function_hook,
+               &call_function_ptr, "CallFunction")) {
+        hook_manager::impl::register_hook_detour(addr);
+    }
 }
 
 #pragma endregion
@@ -129,14 +137,19 @@ const constinit Pattern<41> PROCESS_EVENT_SIG{
     "48 31 E8"              // xor rax, rbp
     "48 89 45 40"           // mov [rbp+40h], rax
 };
+const PrescanEntry<BL4Hook> PROCESS_EVENT_SIG_PRESCAN{PROCESS_EVENT_SIG};
 
 void process_event_hook(UObject* obj, UFunction* func, void* params) {
+    const profiler::impl::ScopedCall profile{func};
+
     try {
-        auto data = hook_manager::impl::preprocess_hook(L"ProcessEvent", func, obj);
+        auto data =
+            hook_manager::impl::preprocess_hook(hook_manager::Source::PROCESS_EVENT, func, obj);
         if (data != nullptr) {
-            // Copy args so that hooks can't modify them, for parity with call function
+            // Hooks get a view of the args, which gets copied the first time they try to modify it,
+            // so that they can't modify the real args, for parity with call function
             const WrappedStruct args_base{func, params};
-            WrappedStruct args = args_base.copy_params_only();
+            WrappedStruct args = args_base.copy_params_on_write();
             hook_manager::Details hook{.obj = obj,
                                        .args = &args,
                                        .ret = {func->find_return_param()},
@@ -190,11 +203,14 @@ static_assert(std::is_same_v<decltype(process_event_hook), decltype(locking_proc
 }  // namespace
 
 void BL4Hook::hook_process_event(void) {
-    detour(PROCESS_EVENT_SIG,
-           // If we don't need locks, it's slightly more efficient to detour directly to the
-           // non-locking version
-           locks::FunctionCall::enabled() ? locking_process_event_hook : process_event_hook,
-           &process_event_ptr, "ProcessEvent");
+    auto addr = PROCESS_EVENT_SIG.sigscan_nullable();
+    if (detour(addr,
+               // If we don't need locks, it's slightly more efficient to detour directly to the
+               // non-locking version
+               locks::FunctionCall::enabled() ? locking_process_event_hook : process_event_hook,
+               &process_event_ptr, "ProcessEvent")) {
+        hook_manager::impl::register_hook_detour(addr);
+    }
 }
 
 void BL4Hook::process_event(UObject* object, UFunction* func, void* params) const {
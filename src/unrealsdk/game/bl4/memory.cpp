@@ -1,5 +1,6 @@
 #include "unrealsdk/pch.h"
 #include "unrealsdk/memory.h"
+#include "unrealsdk/profiler.h"
 #include "unrealsdk/game/bl4/bl4.h"
 #include "unrealsdk/unreal/alignment.h"
 
@@ -28,8 +29,10 @@ const constexpr Pattern<52> GMALLOC_SIG{
     "48 8B 0D ????????"    // mov rcx, [Borderlands4.exe+C4DBF30]
     "EB ??"                // jmp Borderlands4.exe+1D82D
     "CC"                   // int 3
-    "48 89 C8"             // mov rax, rcx
+    "48 89 C8",            // mov rax, rcx
+    SectionType::CODE,
 };
+const PrescanEntry<BL4Hook> GMALLOC_SIG_PRESCAN{GMALLOC_SIG};
 
 struct FMalloc;
 struct FMallocVFtable {
@@ -57,9 +60,12 @@ FMalloc* gmalloc;
 
 void BL4Hook::find_gmalloc(void) {
     volatile auto gmalloc_ptr = read_offset<FMalloc**>(GMALLOC_SIG.sigscan("GMalloc"));
-    while (*gmalloc_ptr == nullptr) {
-        // NOLINTNEXTLINE(readability-magic-numbers)
-        std::this_thread::sleep_for(std::chrono::milliseconds{50});
+    {
+        const profiler::impl::ScopedStartupPhase phase{"wait_for_gmalloc"};
+        while (*gmalloc_ptr == nullptr) {
+            // NOLINTNEXTLINE(readability-magic-numbers)
+            std::this_thread::sleep_for(std::chrono::milliseconds{50});
+        }
     }
 
     gmalloc = *gmalloc_ptr;
@@ -49,6 +49,7 @@ const constinit Pattern<42> GET_OBJ_PATH_NAME_PATTERN{
     "48 85 C9"              // test rcx, rcx
     "0F84 ????????"         // je Borderlands4.exe+4261FF6
 };
+const PrescanEntry<BL4Hook> GET_OBJ_PATH_NAME_PATTERN_PRESCAN{GET_OBJ_PATH_NAME_PATTERN};
 
 using get_field_path_name_func = ManagedFString* (*)(const FField* self,
                                                      ManagedFString* ret,
@@ -72,6 +73,7 @@ const constinit Pattern<67> GET_FIELD_PATH_NAME_PATTERN{
     "48 8D 7C 24 ??"        // lea rdi, [rsp+30]
     "4C 89 C2"              // mov rdx, r8
 };
+const PrescanEntry<BL4Hook> GET_FIELD_PATH_NAME_PATTERN_PRESCAN{GET_FIELD_PATH_NAME_PATTERN};
 
 }  // namespace
 
@@ -159,6 +161,7 @@ const constinit Pattern<39> CONSTRUCT_OBJECT_PATTERN{
     "48 89 84 24 ????????"  // mov [rsp+00000270], rax
     "48 8B 39"              // mov rdi, [rcx]
 };
+const PrescanEntry<BL4Hook> CONSTRUCT_OBJECT_PATTERN_PRESCAN{CONSTRUCT_OBJECT_PATTERN};
 
 }  // namespace
 
@@ -211,6 +214,7 @@ const constinit Pattern<23> STATIC_FIND_OBJECT_PATTERN{
     "48 83 EC 28"        // sub rsp, 28
     "F6 05 ???????? 01"  // test byte ptr [Borderlands4.exe+C5B2940], 01
 };
+const PrescanEntry<BL4Hook> STATIC_FIND_OBJECT_PATTERN_PRESCAN{STATIC_FIND_OBJECT_PATTERN};
 
 const constexpr intptr_t ANY_PACKAGE = -1;
 
@@ -257,6 +261,7 @@ const constinit Pattern<50> LOAD_PACKAGE_PATTERN{
     "0F84 ????????"         // je Borderlands4.exe+2546480
     "4D 89 CF"              // mov r15, r9
 };
+const PrescanEntry<BL4Hook> LOAD_PACKAGE_PATTERN_PRESCAN{LOAD_PACKAGE_PATTERN};
 
 }  // namespace
 
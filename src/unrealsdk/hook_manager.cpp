@@ -1,7 +1,11 @@
 #include "unrealsdk/pch.h"
 
+#include "unrealsdk/call_trace.h"
+#include "unrealsdk/commands.h"
 #include "unrealsdk/config.h"
 #include "unrealsdk/hook_manager.h"
+#include "unrealsdk/locks.h"
+#include "unrealsdk/profiler.h"
 #include "unrealsdk/unreal/classes/ufunction.h"
 #include "unrealsdk/unreal/classes/uobject.h"
 #include "unrealsdk/unreal/structs/fframe.h"
@@ -16,26 +20,77 @@ namespace unrealsdk::hook_manager {
 
 using DLLSafeCallback = utils::DLLSafeCallback<Callback>;
 
-#pragma region Implementation
-#ifndef UNREALSDK_IMPORTING
-namespace impl {
+// Used to pass hook stats over the dll boundary, without needing to allocate on the other side
+struct HookStatsView {
+    const wchar_t* func;
+    size_t func_size;
+    Type type;
+    const wchar_t* identifier;
+    size_t identifier_size;
+    uint64_t count;
+    uint64_t total_ns;
+    uint64_t max_ns;
+};
 
-/*
-The fact that hooks run arbitrary user provided callbacks means our data structure can get modified
-in a number of awkward ways while we're in the middle of iterating over it. There's the obvious case
-of a hook can remove itself, but also tricker ones like a hook can invoke a nested hook on itself,
-and only remove itself there, or the upper layer hook could remove itself and the nested one could
-re-add it, etc. It gets even messier if we consider threading.
+using HookStatsVisitor = void(void* ctx, const HookStatsView* stats);
 
-So the number one concern behind this design is robustness - we need to support essentially
-arbitrary modification while we're in the middle of iterating through it. This means performance is
-a secondary concern - though I still tried keeping it mind - I haven't done any benchmarking.
+// Used to pass batches of hooks over the dll boundary
+struct HookSpecView {
+    const wchar_t* func;
+    size_t func_size;
+    Type type;
+    const wchar_t* identifier;
+    size_t identifier_size;
+    // Moved from when the hook is added
+    DLLSafeCallback* callback;
+    int32_t priority;
+    Filter filter;
+};
 
-The easiest way to keep our iterators valid is to use linked lists. However, using a bunch of
-`std::list`s isn't the best for performance, as we'll discuss in a bit, since need several layers
-of them, so instead we use a bunch of intrusive linked lists on our own type.
+struct HookIdView {
+    const wchar_t* func;
+    size_t func_size;
+    Type type;
+    const wchar_t* identifier;
+    size_t identifier_size;
+};
 
+#pragma region Implementation
+#ifndef UNREALSDK_IMPORTING
+namespace impl {
 
+/*
+Hooks get run from whichever thread the unreal function was called on, while they may get added or
+removed from any other thread, or even from inside another hook. Hook processing is also very hot -
+thousands if not tens of thousands of calls are made every second. So the design is read-mostly: we
+want readers to be able to look up and run hooks without taking any locks, and without touching any
+shared reference counts.
+
+To do this, the hooks readers see are stored in an immutable snapshot. Writers take a lock, modify
+the registry (a plain map of all hooks, which only they ever touch), then build a whole new snapshot
+out of it, and atomically swap the current snapshot pointer to point at it. Readers just load the
+current snapshot pointer, and are free to traverse it using plain loads.
+
+This of course raises the problem of when we can free the old snapshots - a reader may still be
+iterating through it (including being halfway through running callbacks) when it gets swapped out.
+We use epoch based reclamation for this. Each thread which reads the hooks has a record, on which it
+publishes the epoch it started reading in, and clears it when it finishes. When a writer swaps out
+a snapshot, it advances the global epoch, and retires the old snapshot tagged with the epoch it was
+swapped out in. It can be safely freed once every active reader started in a later epoch. Freeing
+is never blocking, if there's still a reader it just gets left for the next writer to try again.
+
+Since the read side should be as fast as possible, it doesn't even use a proper fence when
+publishing it's epoch. Instead, writers call `FlushProcessWriteBuffers` before they look through
+the records, which forces a full memory barrier on every thread which might be mid-way through
+publishing one.
+
+Hooks can be called recursively, so the records hold a depth, and only the outermost call publishes
+an epoch. The epoch must be held for the entire time a call is being processed, since we keep on
+using the same snapshot for all the hook types. Note this means if a hooked function takes a long
+time to run, nothing retired in the meantime will be freed until it finishes.
+
+The snapshot itself is laid out as a hash table, indexed by FName, which points to an intrusive
+linked list, so that calls which aren't hooked can be discarded as quickly as possible.
 The most basic form of the data structure we want is essentially a:
     map<FName, map<full_name, map<Type, collection<pair<identifier, callback>>>>>
 
@@ -44,111 +99,813 @@ comparison on the full name. After matching both of them, we then need to split
 finally gets us the collection of callbacks to run. The identifiers have no influence when matching
 hooks, they're only used when adding/removing them.
 
-The smallest unit we have to iterate over is the hooks of the same type on the same function - the
-one labeled just "collection" above. This is the `next_in_collection` linked list.
-
-Then we need to be able to jump between the collections on the same hook, but of different type. The
-heads of the collection linked lists form into a second `next_type` linked list. We use an intrusive
-linked list, so the exact same node from the above list also holds the pointers for this one.
-
-Above that, we need to jump between groups of hooks which share the same fname, but have different
-full function names. The heads of the type linked lists form the third `next_function` linked list.
-
-Finally, we need to iterate through FNames. We actually do this using a hash table - but we still
-need to deal with collisions. The heads of the function linked lists form our fourth and final
-`next_collision` linked list.
-
-Trying to roughly diagram an example, this is what might be in a single hash bucket:
-
-Collision  | [A] -----------------------------> [F]
-           |  :                                  :
-Function   | [A] ---------------> [D]           [F] -> [G]
-           |  :                    :             :      :
-Type       | [A] --------> [C]     :             :      :
-           |  :             :      :             :      :
-Collection | [A] -> [B]    [C]    [D] -> [E]    [F]    [G]
-
-[A] Class::Func, post-hook
-[B] Class::Func, post-hook
-[C] Class::Func, pre-hook
-[D] OtherClass::Func
-[E] OtherClass::Func
-[F] ThirdClass::SomeOtherFunc, where `SomeOtherFunc` and `Func` happen to get a hash collision
-[G] FourthClass::SomeOtherFunc
-
-Each column is a single node, a node may be in multiple linked lists.
+Each function gets a single node. We need to be able to jump between the nodes of functions which
+share the same fname, but have different full function names - this is the `next_function` linked
+list. The heads of these lists are stored in an open addressing (linear probing) hash table, keyed
+on the full 64-bit FName. Some games pack name indexes as block/offset pairs, so they're run through
+a proper mixing hash first, to spread them over the whole table. Since a new snapshot gets built on
+every change anyway, the table is simply sized for the number of functions it holds, keeping the
+load factor at or below a half, which keeps probes short.
+
+Trying to roughly diagram an example:
+
+Table     | [A]   [ ]   [C]   [ ]
+          |  :           :
+Function  | [A] -> [B]  [C] -> [D]
+
+[A] Class::Func
+[B] OtherClass::Func
+[C] ThirdClass::SomeOtherFunc
+[D] FourthClass::SomeOtherFunc
+
+Once we've found a function's node, splitting by type is just an array index. All the hooks in the
+snapshot are stored in one contiguous array - grouped by function, then by type, then sorted into
+the order they should be run in - and each node holds a span into it per type. This means running
+all the hooks on a function just walks through a single block of memory, which matters on functions
+which get called every frame and have a lot of hooks.
+
+Since a snapshot is only ever built in one go, and is never modified after it's published, the
+nodes don't need to deal with any of the messy insertion/removal logic, or to own anything. The
+actual hook data lives in a separate `Hook` object, which outlives every snapshot it's used in.
 */
 
-struct Node {
+const constexpr auto HOOK_TYPE_COUNT = static_cast<size_t>(Type::POST_UNCONDITIONAL) + 1;
+
+struct Hook {
    public:
     FName fname;
     std::wstring full_name;
     Type type;
     std::wstring identifier;
-    DLLSafeCallback callback;
-
-    // Using shared pointers because it's easy
-    // Since we use std::make_shared, we're not really wasting allocations, but as a future
-    // optimization we could use an intrusive reference count to avoid repeating all the control
-    // block pointers, and save a little memory.
-    std::shared_ptr<Node> next_collision = nullptr;
-    std::shared_ptr<Node> next_function = nullptr;
-    std::shared_ptr<Node> next_type = nullptr;
-    std::shared_ptr<Node> next_in_collection = nullptr;
-
-    Node(FName fname,
+    int32_t priority;
+    Filter filter;
+
+    // What actually gets run. Hooks added with a `std::function` point this at a forwarder to their
+    // dll safe callback, so that running any hook is a single indirect call.
+    RawCallback* raw_callback;
+    void* ctx;
+    RawCallbackContextDeleter* ctx_deleter = nullptr;
+    std::optional<DLLSafeCallback> callback;
+
+    // Set when the hook is removed, so that it's skipped if something earlier in the same call
+    // removes it, even though that call is still using an older snapshot.
+    std::atomic<bool> removed = false;
+
+    // Timing stats, only updated while hook timing is enabled
+    std::atomic<uint64_t> call_count = 0;
+    std::atomic<uint64_t> total_ns = 0;
+    std::atomic<uint64_t> max_ns = 0;
+
+    Hook(FName fname,
          std::wstring_view full_name,
          Type type,
          std::wstring_view identifier,
+         int32_t priority,
+         const Filter& filter,
          DLLSafeCallback&& callback)
         : fname(fname),
           full_name(full_name),
           type(type),
           identifier(identifier),
-          callback(std::move(callback)) {}
+          priority(priority),
+          filter(filter),
+          raw_callback(&Hook::call_dll_safe_callback),
+          ctx(nullptr),
+          callback(std::move(callback)) {
+        // Hooks never move, so this is stable
+        this->ctx = &*this->callback;
+    }
+
+    Hook(FName fname,
+         std::wstring_view full_name,
+         Type type,
+         std::wstring_view identifier,
+         int32_t priority,
+         const Filter& filter,
+         RawCallback* callback,
+         void* ctx,
+         RawCallbackContextDeleter* ctx_deleter)
+        : fname(fname),
+          full_name(full_name),
+          type(type),
+          identifier(identifier),
+          priority(priority),
+          filter(filter),
+          raw_callback(callback),
+          ctx(ctx),
+          ctx_deleter(ctx_deleter) {}
+
+    ~Hook() {
+        if (this->ctx_deleter != nullptr) {
+            this->ctx_deleter(this->ctx);
+        }
+    }
+
+    Hook(const Hook&) = delete;
+    Hook(Hook&&) = delete;
+    Hook& operator=(const Hook&) = delete;
+    Hook& operator=(Hook&&) = delete;
+
+   private:
+    static bool call_dll_safe_callback(Details* details, void* ctx) {
+        return (*static_cast<DLLSafeCallback*>(ctx))(*details);
+    }
+};
+
+struct Node {
+   public:
+    FName fname;
+    // Points into one of the hooks, which are guaranteed to outlive the snapshot
+    std::wstring_view full_name;
+
+    // The hooks of each type, in the order they should be run, pointing into the snapshot's array
+    std::array<std::span<Hook* const>, HOOK_TYPE_COUNT> hooks;
+    // If every hook has a filter - if so, calls need to match one of them before being processed
+    bool all_filtered = true;
+
+    Node* next_function = nullptr;
 };
 
 namespace {
 
-const constexpr auto HASH_TABLE_SIZE = 0x1000;
-std::array<std::shared_ptr<Node>, HASH_TABLE_SIZE> hooks_hash_table;
+const constexpr size_t MIN_TABLE_SIZE = 0x10;
+// The table is sized so that it's at most 1/N full
+const constexpr size_t TABLE_LOAD_FACTOR_INVERSE = 2;
+
+const constexpr auto SOURCE_COUNT = static_cast<size_t>(Source::CALL_FUNCTION);
+
+/**
+ * @brief Gets the index of a (specific) call source, for use in per-source arrays.
+ *
+ * @param source The call source. May not be `Source::ANY`.
+ * @return The source's index.
+ */
+constexpr size_t get_source_index(Source source) {
+    return static_cast<size_t>(source) - 1;
+}
+
+/**
+ * @brief Checks if a hook runs on calls from the given source.
+ *
+ * @param hook The hook to check.
+ * @param source The call source. May not be `Source::ANY`.
+ * @return True if the hook runs on calls from the source.
+ */
+bool runs_on_source(const Hook& hook, Source source) {
+    return hook.filter.source == Source::ANY || hook.filter.source == source;
+}
+
+struct SourceTable {
+    // The heads of each function list, open addressed. Always a power of two in size.
+    std::vector<Node*> table;
+    // One per hooked function
+    std::vector<Node> nodes;
+    // Every hook, grouped by function, then by type, in run order
+    std::vector<Hook*> hooks;
+
+    // How many function lists there are, and how far they ended up from their ideal slots
+    size_t name_count = 0;
+    size_t max_probe_length = 0;
+    size_t total_probe_length = 0;
+};
+
+struct Snapshot {
+    // Unique per snapshot, never reused, unlike it's address
+    uint64_t generation;
+
+    // One table per call source, each only containing the hooks which run on it
+    std::array<SourceTable, SOURCE_COUNT> sources;
+};
 
 /**
- * @brief Hashes the given fname, and returns which index of the table it goes in.
+ * @brief Hashes the given fname.
  *
- * @param name The name to check.
- * @return The hash table index.
+ * @param name The name to hash.
+ * @return The hash.
  */
-size_t get_table_index(FName fname) {
+size_t hash_fname(FName fname) {
     static_assert(sizeof(unrealsdk::unreal::FName) == sizeof(uint64_t),
                   "FName is not same size as a uint64");
     uint64_t val{};
     memcpy(&val, &fname, sizeof(fname));
 
-    // Identity seems mostly good enough - FNames already are just a relatively small integer value.
-    // This throws away the number field, but that's very rarely used on functions to begin with.
-    return val % HASH_TABLE_SIZE;
+    // Murmur3's 64-bit finalizer, so that every bit of the index and number affects the low bits
+    val ^= val >> 33;
+    val *= 0xFF51AFD7ED558CCDULL;
+    val ^= val >> 33;
+    val *= 0xC4CEB9FE1A85EC53ULL;
+    val ^= val >> 33;
+    return static_cast<size_t>(val);
+}
+
+#pragma region Epoch Based Reclamation
+
+std::atomic<uint64_t> global_epoch{1};
+
+struct ReaderRecord {
+    // The epoch the thread owning this record started reading in, or 0 if it's not reading
+    std::atomic<uint64_t> epoch = 0;
+    std::atomic<bool> in_use = true;
+    ReaderRecord* next = nullptr;
+};
+
+// Records are never freed, when a thread exits it's record is left behind for the next one
+std::atomic<ReaderRecord*> reader_records{nullptr};
+
+/**
+ * @brief Gets a reader record for the current thread, either reusing an old one or creating one.
+ *
+ * @return The record.
+ */
+ReaderRecord* acquire_reader_record(void) {
+    for (auto record = reader_records.load(std::memory_order_acquire); record != nullptr;
+         record = record->next) {
+        bool expected = false;
+        if (record->in_use.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+            return record;
+        }
+    }
+
+    // NOLINTNEXTLINE(cppcoreguidelines-owning-memory)
+    auto record = new ReaderRecord{};
+    record->next = reader_records.load(std::memory_order_relaxed);
+    while (!reader_records.compare_exchange_weak(record->next, record, std::memory_order_release,
+                                                 std::memory_order_relaxed)) {}
+    return record;
+}
+
+struct ThreadReader {
+    ReaderRecord* record = acquire_reader_record();
+    size_t depth = 0;
+
+    ThreadReader(void) = default;
+    ~ThreadReader() { this->record->in_use.store(false, std::memory_order_release); }
+
+    ThreadReader(const ThreadReader&) = delete;
+    ThreadReader(ThreadReader&&) = delete;
+    ThreadReader& operator=(const ThreadReader&) = delete;
+    ThreadReader& operator=(ThreadReader&&) = delete;
+};
+
+thread_local ThreadReader thread_reader{};
+
+/**
+ * @brief Enters a read section, during which nothing loaded from the current snapshot may be freed.
+ * @note May be nested.
+ */
+void enter_read_section(void) {
+    if (thread_reader.depth++ == 0) {
+        thread_reader.record->epoch.store(global_epoch.load(std::memory_order_acquire),
+                                          std::memory_order_relaxed);
+        // The other half of this fence is the `FlushProcessWriteBuffers` writers call
+        std::atomic_signal_fence(std::memory_order_seq_cst);
+    }
+}
+
+/**
+ * @brief Exits a read section, after which previously loaded pointers may be freed at any time.
+ */
+void exit_read_section(void) {
+    if (--thread_reader.depth == 0) {
+        thread_reader.record->epoch.store(0, std::memory_order_release);
+    }
+}
+
+#pragma endregion
+
+#pragma region Hook Pool
+
+/*
+Hooks are allocated out of a pool of fixed size slabs, rather than individually on the heap. Hooks
+on the same function are typically all added around the same time, so this tends to keep them next
+to each other in memory, meaning running them all touches far fewer cache lines. Freed slots get
+reused before any new slabs are allocated, so the pool only ever grows to the most hooks which were
+alive at once.
+
+Hooks are freed outside of the hooks mutex (see `collect_reclaimable`), so the pool has it's own.
+*/
+
+class HookPool {
+   private:
+    static const constexpr auto SLAB_SIZE = 64;
+
+    union Slot {
+        Slot* next_free;
+        alignas(Hook) std::byte storage[sizeof(Hook)];
+    };
+    using Slab = std::array<Slot, SLAB_SIZE>;
+
+    std::mutex mutex;
+    std::vector<std::unique_ptr<Slab>> slabs;
+    Slot* free_list = nullptr;
+
+   public:
+    /**
+     * @brief Creates a new hook in the pool.
+     *
+     * @param args The args to forward to the hook's constructor.
+     * @return A pointer to the new hook.
+     */
+    template <typename... Args>
+    Hook* create(Args&&... args) {
+        Slot* slot{};
+        {
+            const std::scoped_lock lock(this->mutex);
+            if (this->free_list == nullptr) {
+                auto& slab = this->slabs.emplace_back(std::make_unique<Slab>());
+                // Push in reverse, so that we allocate in address order
+                for (auto& new_slot : std::ranges::reverse_view(*slab)) {
+                    new_slot.next_free = this->free_list;
+                    this->free_list = &new_slot;
+                }
+            }
+
+            slot = this->free_list;
+            this->free_list = slot->next_free;
+        }
+
+        try {
+            return new (&slot->storage) Hook(std::forward<Args>(args)...);
+        } catch (...) {
+            this->release(slot);
+            throw;
+        }
+    }
+
+    /**
+     * @brief Destroys a hook, and returns it's slot to the pool.
+     *
+     * @param hook The hook to destroy.
+     */
+    void destroy(Hook* hook) {
+        hook->~Hook();
+        // The storage is the first (and only) member of the slot, so they share an address
+        this->release(reinterpret_cast<Slot*>(hook));
+    }
+
+   private:
+    void release(Slot* slot) {
+        const std::scoped_lock lock(this->mutex);
+        slot->next_free = this->free_list;
+        this->free_list = slot;
+    }
+};
+
+// Must be defined before anything which holds hooks, so that it gets destroyed after them
+HookPool hook_pool{};
+
+struct HookDeleter {
+    void operator()(Hook* hook) const { hook_pool.destroy(hook); }
+};
+
+using HookPtr = std::unique_ptr<Hook, HookDeleter>;
+
+#pragma endregion
+
+std::atomic<const Snapshot*> current_snapshot{nullptr};
+
+// Everything below is protected by the hooks mutex
+
+std::mutex hooks_mutex{};
+
+struct FunctionHooks {
+    FName fname;
+    // One list per hook type, each in the order they should be run
+    std::array<std::vector<HookPtr>, HOOK_TYPE_COUNT> hooks;
+};
+
+// Maps full function names to all the hooks on them
+utils::StringViewMap<std::wstring, FunctionHooks> registry{};
+
+uint64_t snapshot_generation = 0;
+
+struct Retired {
+    uint64_t epoch;
+    std::unique_ptr<const Snapshot> snapshot;
+    std::vector<HookPtr> hooks;
+};
+
+std::vector<Retired> retired{};
+
+/**
+ * @brief Builds the table for a single call source out of the current registry.
+ *
+ * @param source The source to build the table for.
+ * @param source_table The table to fill in.
+ */
+void build_source_table(Source source, SourceTable& source_table) {
+    size_t total_functions = 0;
+    size_t total_hooks = 0;
+    for (const auto& [_, function] : registry) {
+        size_t function_hooks = 0;
+        for (const auto& hooks : function.hooks) {
+            function_hooks += static_cast<size_t>(std::ranges::count_if(
+                hooks, [source](auto& hook) { return runs_on_source(*hook, source); }));
+        }
+        if (function_hooks > 0) {
+            total_functions++;
+            total_hooks += function_hooks;
+        }
+    }
+    // Must never reallocate, or we'd invalidate all the pointers into them
+    source_table.nodes.reserve(total_functions);
+    source_table.hooks.reserve(total_hooks);
+
+    source_table.table.resize(
+        std::bit_ceil(std::max(MIN_TABLE_SIZE, total_functions * TABLE_LOAD_FACTOR_INVERSE)));
+
+    for (const auto& [_, function] : registry) {
+        Node node{};
+        node.fname = function.fname;
+
+        for (size_t type = 0; type < HOOK_TYPE_COUNT; type++) {
+            auto start = source_table.hooks.size();
+            for (const auto& hook : function.hooks.at(type)) {
+                if (!runs_on_source(*hook, source)) {
+                    continue;
+                }
+                source_table.hooks.push_back(hook.get());
+                node.full_name = hook->full_name;
+                if (hook->filter.object == nullptr && hook->filter.cls == nullptr) {
+                    node.all_filtered = false;
+                }
+            }
+            node.hooks.at(type) = std::span{source_table.hooks}.subspan(
+                start, source_table.hooks.size() - start);
+        }
+
+        // If no hooks on this function run on this source, it doesn't get a node at all
+        if (node.full_name.empty()) {
+            continue;
+        }
+        auto& inserted_node = source_table.nodes.emplace_back(node);
+
+        auto mask = source_table.table.size() - 1;
+        size_t probe_length = 0;
+        auto idx = hash_fname(inserted_node.fname) & mask;
+        for (; source_table.table[idx] != nullptr
+               && source_table.table[idx]->fname != inserted_node.fname;
+             idx = (idx + 1) & mask) {
+            probe_length++;
+        }
+
+        auto& slot = source_table.table[idx];
+        if (slot == nullptr) {
+            // No other functions share our fname, start a new functions list
+            slot = &inserted_node;
+            source_table.name_count++;
+            source_table.max_probe_length = std::max(source_table.max_probe_length, probe_length);
+            source_table.total_probe_length += probe_length;
+        } else {
+            // Insert just after the head of the existing functions list
+            inserted_node.next_function = slot->next_function;
+            slot->next_function = &inserted_node;
+        }
+    }
+}
+
+/**
+ * @brief Builds a new snapshot out of the current registry.
+ *
+ * @return The new snapshot.
+ */
+std::unique_ptr<Snapshot> build_snapshot(void) {
+    auto snapshot = std::make_unique<Snapshot>();
+    snapshot->generation = ++snapshot_generation;
+
+    build_source_table(Source::PROCESS_EVENT,
+                       snapshot->sources.at(get_source_index(Source::PROCESS_EVENT)));
+    build_source_table(Source::CALL_FUNCTION,
+                       snapshot->sources.at(get_source_index(Source::CALL_FUNCTION)));
+
+    return snapshot;
+}
+
+#pragma region Name Filter
+
+/*
+The vast majority of calls are to functions which aren't hooked, so before even looking at the
+snapshot, we check a small bitset of name indexes which might be hooked. At 2kb, this comfortably
+stays in L1, so rejecting an unhooked call costs a single bit test. Like the tables, there's one
+filter per call source.
+
+Rather than tracking which hooks set which bits, writers simply recalculate the whole filter from
+the registry every time they publish a new snapshot. To make sure readers never incorrectly reject
+a call, new bits are set before the snapshot is published, and old bits are only cleared after.
+Readers only ever use relaxed loads - if they race a writer they might see either version, but that
+was already true of the snapshot.
+*/
+
+const constexpr auto NAME_FILTER_BITS_LOG2 = 14;
+const constexpr auto NAME_FILTER_BITS = 1 << NAME_FILTER_BITS_LOG2;
+const constexpr auto NAME_FILTER_WORD_BITS = std::numeric_limits<uint64_t>::digits;
+
+const constexpr auto NAME_FILTER_WORD_COUNT = NAME_FILTER_BITS / NAME_FILTER_WORD_BITS;
+
+using NameFilterWords = std::array<uint64_t, NAME_FILTER_WORD_COUNT>;
+
+std::array<std::array<std::atomic<uint64_t>, NAME_FILTER_WORD_COUNT>, SOURCE_COUNT> name_filters{};
+
+/**
+ * @brief Gets which bit of the name filter an fname maps to.
+ *
+ * @param fname The name to check.
+ * @return The bit index.
+ */
+size_t get_name_filter_bit(FName fname) {
+    // Only use the index (which is the first field), the number is very rarely used on functions
+    uint32_t index{};
+    memcpy(&index, &fname, sizeof(index));
+
+    // Depending on game, name indexes may be packed with a block number or stepped by alignment,
+    // so mix them a little (Fibonacci hashing) to stop the low bits from clumping
+    const constexpr uint32_t multiplier = 0x9E3779B9;
+    return (index * multiplier) >> (std::numeric_limits<uint32_t>::digits - NAME_FILTER_BITS_LOG2);
+}
+
+/**
+ * @brief Checks if a function with the given name could possibly be hooked.
+ *
+ * @param source The source of the call.
+ * @param fname The function's name.
+ * @return False if the function is definitely not hooked, true if it might be.
+ */
+bool might_be_hooked(Source source, FName fname) {
+    auto bit = get_name_filter_bit(fname);
+    return (name_filters[get_source_index(source)][bit / NAME_FILTER_WORD_BITS].load(
+                std::memory_order_relaxed)
+            & (1ULL << (bit % NAME_FILTER_WORD_BITS)))
+           != 0;
+}
+
+/**
+ * @brief Calculates what a name filter should contain for the current registry.
+ * @note Must be called while holding the hooks mutex.
+ *
+ * @param source The source to calculate the filter of.
+ * @return The new filter words.
+ */
+NameFilterWords calculate_name_filter(Source source) {
+    NameFilterWords words{};
+    for (const auto& [_, function] : registry) {
+        if (std::ranges::none_of(function.hooks, [source](auto& hooks) {
+                return std::ranges::any_of(
+                    hooks, [source](auto& hook) { return runs_on_source(*hook, source); });
+            })) {
+            continue;
+        }
+
+        auto bit = get_name_filter_bit(function.fname);
+        words.at(bit / NAME_FILTER_WORD_BITS) |= 1ULL << (bit % NAME_FILTER_WORD_BITS);
+    }
+    return words;
+}
+
+#pragma endregion
+
+#pragma region Idle Detours
+
+/*
+The detours which run hooks cost something on every single unreal call, even when there's nothing
+for them to do. While there are no hooks, and nothing else which needs to see every call, we
+disable them entirely, so that calls go straight to the original function.
+
+Toggling a detour means suspending every other thread while the code gets patched, so this only
+happens when going between having nothing and something to do, not on every hook change. It's also
+never done while holding the hooks mutex, or from inside a hook. Hooks may be added or removed from
+a callback, at which point the calling thread may be in the middle of anything. Instead, we just
+mark a refresh as pending, and apply it once all hooks on that thread have finished running. While
+a hook is running the detours are necessarily already enabled, so deferring never loses a call.
+
+This can't be done while function call locking is enabled, since the detours are also what take
+the lock.
+*/
+
+std::mutex detours_mutex{};
+std::vector<uintptr_t> hook_detours{};
+bool hook_detours_enabled = true;
+
+std::atomic<bool> hook_detours_refresh_pending = false;
+
+std::atomic<bool> has_hooks = false;
+std::atomic<bool> should_log_all_calls = false;
+
+/**
+ * @brief Checks if we're allowed to disable the hook detours at all.
+ *
+ * @return True if the hook detours may be disabled while idle.
+ */
+bool can_disable_hook_detours(void) {
+    static const bool can_disable =
+        !locks::FunctionCall::enabled()
+        && config::get_bool("unrealsdk.disable_idle_detours").value_or(true);
+    return can_disable;
+}
+
+/**
+ * @brief Enables or disables the hook detours, depending on if anything needs them.
+ * @note Must not be called while holding the hooks mutex.
+ * @note If called from inside a hook, deferred until all hooks on this thread have finished.
+ */
+void refresh_hook_detours(void) {
+    if (thread_reader.depth > 0) {
+        hook_detours_refresh_pending.store(true, std::memory_order_release);
+        return;
+    }
+    hook_detours_refresh_pending.store(false, std::memory_order_relaxed);
+
+    const std::scoped_lock lock(detours_mutex);
+
+    const bool needed = !can_disable_hook_detours() || has_hooks.load(std::memory_order_relaxed)
+                        || should_log_all_calls.load(std::memory_order_relaxed)
+                        || profiler::is_enabled();
+    if (needed == hook_detours_enabled || hook_detours.empty()) {
+        return;
+    }
+
+    // Queue them all up, so we only need to suspend all threads once
+    for (auto addr : hook_detours) {
+        auto status = needed ? MH_QueueEnableHook(reinterpret_cast<LPVOID>(addr))
+                             : MH_QueueDisableHook(reinterpret_cast<LPVOID>(addr));
+        if (status != MH_OK) {
+            LOG(ERROR, "Failed to queue toggling hook detour at {:p}; With error: '{}'",
+                reinterpret_cast<void*>(addr), MH_StatusToString(status));
+            return;
+        }
+    }
+    auto status = MH_ApplyQueued();
+    if (status != MH_OK) {
+        LOG(ERROR, "Failed to toggle hook detours; With error: '{}'", MH_StatusToString(status));
+        return;
+    }
+
+    hook_detours_enabled = needed;
+    LOG(MISC, "{} hook detours", needed ? "Enabled" : "Disabled idle");
+}
+
+#pragma endregion
+
+/**
+ * @brief Publishes a new snapshot built from the current registry, and retires the old one.
+ * @note Must be called while holding the hooks mutex.
+ * @note Does not update the hook detours, since that can't be done while holding the mutex - call
+ *       `refresh_hook_detours` after releasing it.
+ *
+ * @param removed_hooks Hooks which have been removed from the registry since the last snapshot.
+ */
+void publish_snapshot(std::vector<HookPtr>&& removed_hooks) {
+    auto snapshot = registry.empty() ? nullptr : build_snapshot();
+    std::array<NameFilterWords, SOURCE_COUNT> new_filters{
+        calculate_name_filter(Source::PROCESS_EVENT),
+        calculate_name_filter(Source::CALL_FUNCTION),
+    };
+
+    for (size_t source = 0; source < SOURCE_COUNT; source++) {
+        for (size_t i = 0; i < NAME_FILTER_WORD_COUNT; i++) {
+            name_filters.at(source).at(i).fetch_or(new_filters.at(source).at(i),
+                                                   std::memory_order_relaxed);
+        }
+    }
+
+    const auto* old_snapshot =
+        current_snapshot.exchange(snapshot.release(), std::memory_order_acq_rel);
+    auto epoch = global_epoch.fetch_add(1, std::memory_order_acq_rel);
+
+    for (size_t source = 0; source < SOURCE_COUNT; source++) {
+        for (size_t i = 0; i < NAME_FILTER_WORD_COUNT; i++) {
+            name_filters.at(source).at(i).store(new_filters.at(source).at(i),
+                                                std::memory_order_relaxed);
+        }
+    }
+
+    if (old_snapshot != nullptr || !removed_hooks.empty()) {
+        retired.push_back({.epoch = epoch,
+                           .snapshot = std::unique_ptr<const Snapshot>{old_snapshot},
+                           .hooks = std::move(removed_hooks)});
+    }
+    has_hooks.store(!registry.empty(), std::memory_order_relaxed);
+}
+
+/**
+ * @brief Removes everything which has been retired and is now safe to free from the retired list.
+ * @note Must be called while holding the hooks mutex.
+ * @note Since freeing a hook may call back into user code, which may try add/remove other hooks,
+ *       the returned list should only be destroyed after releasing the mutex.
+ *
+ * @return A list of everything which may now be freed.
+ */
+[[nodiscard]] std::vector<Retired> collect_reclaimable(void) {
+    if (retired.empty()) {
+        return {};
+    }
+
+    FlushProcessWriteBuffers();
+
+    auto oldest_active_epoch = std::numeric_limits<uint64_t>::max();
+    for (auto record = reader_records.load(std::memory_order_acquire); record != nullptr;
+         record = record->next) {
+        auto epoch = record->epoch.load(std::memory_order_acquire);
+        if (epoch != 0) {
+            oldest_active_epoch = std::min(oldest_active_epoch, epoch);
+        }
+    }
+
+    // Everything retired before the oldest active reader started cannot possibly still be in use
+    auto still_in_use = std::ranges::partition(
+        retired, [oldest_active_epoch](auto& entry) { return entry.epoch >= oldest_active_epoch; });
+
+    std::vector<Retired> reclaimable{};
+    reclaimable.reserve(still_in_use.size());
+    std::ranges::move(still_in_use, std::back_inserter(reclaimable));
+    retired.erase(still_in_use.begin(), still_in_use.end());
+
+    return reclaimable;
+}
+
+/*
+Resolving a call down to a specific function's hooks requires building it's full path name, which
+is relatively slow, and would otherwise happen on every call to a function whose name matches a
+hook. Since the exact same function objects get called over and over again, we cache what each one
+resolved to - including if it resolved to nothing - keyed by pointer.
+
+Cached nodes point into a specific snapshot, so each entry remembers which snapshot it was resolved
+in, and is ignored once we see a new one. Since each call source has it's own table, each also has
+it's own cache.
+
+A function may be freed, and a different one allocated at the same address, without the snapshot
+changing. A path name is made up of the names of the object and each of it's outers, so we store
+that whole chain, and only trust an entry if the function's current chain still matches it. This
+is just a few pointer reads per level, far cheaper than building the path name. Functions nested
+deeper than we can store are just never cached.
+
+The cache is a small, fixed size, direct mapped table, so it never allocates, and never grows past
+it's initial size no matter how many different functions get called. It's thread local, so that it
+can be filled in from whichever thread the call came from, without needing to take any locks.
+*/
+
+const constexpr size_t RESOLVED_HOOK_CACHE_SIZE = 0x40;
+const constexpr size_t MAX_CACHED_OUTER_DEPTH = 8;
+
+struct ResolvedHook {
+    const UFunction* func;
+    uint64_t generation;
+    // The function's name, followed by the name of each of it's outers
+    std::array<FName, MAX_CACHED_OUTER_DEPTH> outer_chain;
+    size_t outer_chain_size;
+    const Node* node;
+};
+
+using ResolvedHookCache = std::array<ResolvedHook, RESOLVED_HOOK_CACHE_SIZE>;
+thread_local std::array<ResolvedHookCache, SOURCE_COUNT> resolved_hook_caches{};
+
+/**
+ * @brief Stores the names of an object and each of it's outers into a cache entry.
+ *
+ * @param obj The object to get the chain of.
+ * @param entry The entry to store the chain in.
+ * @return False if the chain was too long to store.
+ */
+bool store_outer_chain(const UObject* obj, ResolvedHook& entry) {
+    entry.outer_chain_size = 0;
+    for (; obj != nullptr; obj = obj->Outer()) {
+        if (entry.outer_chain_size >= MAX_CACHED_OUTER_DEPTH) {
+            return false;
+        }
+        entry.outer_chain.at(entry.outer_chain_size++) = obj->Name();
+    }
+    return true;
 }
 
-bool should_log_all_calls = false;
-std::wofstream log_all_calls_stream{};
-std::mutex log_all_calls_stream_mutex{};
+/**
+ * @brief Checks if an object's outer chain matches one we previously saw.
+ *
+ * @param obj The object to check.
+ * @param chain The previously seen outer chain.
+ * @return True if the object's names match the chain exactly.
+ */
+bool outer_chain_matches(const UObject* obj, std::span<const FName> chain) {
+    for (const auto& name : chain) {
+        if (obj == nullptr || obj->Name() != name) {
+            return false;
+        }
+        obj = obj->Outer();
+    }
+    return obj == nullptr;
+}
 
 void log_all_calls(bool should_log) {
-    // Only keep this file stream open while we need it
+    // Only keep the trace running while we need it
     if (should_log) {
-        const std::scoped_lock lock(log_all_calls_stream_mutex);
-        log_all_calls_stream.open(
+        call_trace::start(
             utils::get_this_dll().parent_path()
-                / config::get_str("unrealsdk.log_all_calls_file").value_or("unrealsdk.calls.tsv"),
-            std::wofstream::trunc);
+            / config::get_str("unrealsdk.log_all_calls_file").value_or("unrealsdk.calls.bin"));
     }
 
-    should_log_all_calls = should_log;
+    should_log_all_calls.store(should_log, std::memory_order_relaxed);
+    refresh_hook_detours();
 
     if (!should_log) {
-        const std::scoped_lock lock(log_all_calls_stream_mutex);
-        log_all_calls_stream.close();
+        call_trace::stop();
     }
 }
 
@@ -172,335 +929,997 @@ FName extract_func_obj_name(std::wstring_view func) {
     return FName{std::wstring{func.substr(idx + 1)}};
 }
 
+/**
+ * @brief Inserts a hook into the registry, without publishing it.
+ * @note Assumes the hooks mutex is held.
+ *
+ * @tparam CallbackArgs The types of the callback args.
+ * @param func The function to hook.
+ * @param fname The FName we expect the function to have.
+ * @param type Which type of hook to add.
+ * @param identifier The hook identifier.
+ * @param priority The hook's priority.
+ * @param filter The hook's filter.
+ * @param callback_args The args to construct the hook's callback from.
+ * @return True if successfully inserted, false if an identical hook already existed.
+ */
+template <typename... CallbackArgs>
+bool insert_hook(std::wstring_view func,
+                 FName fname,
+                 Type type,
+                 std::wstring_view identifier,
+                 int32_t priority,
+                 const Filter& filter,
+                 CallbackArgs&&... callback_args) {
+    auto iter = registry.find(func);
+    if (iter == registry.end()) {
+        iter =
+            registry.emplace(std::wstring{func}, FunctionHooks{.fname = fname, .hooks = {}}).first;
+    }
+
+    auto& hooks = iter->second.hooks.at(static_cast<size_t>(type));
+    if (std::ranges::any_of(hooks, [identifier](auto& hook) {
+            return hook->identifier == identifier;
+        })) {
+        // We already have this identifier, can't insert
+        return false;
+    }
+
+    // Keep the list sorted by descending priority, inserting after any existing hooks of the same
+    // priority, so they run in the order they were added
+    auto insert_pos = std::ranges::upper_bound(hooks, priority, std::ranges::greater{},
+                                               [](auto& hook) { return hook->priority; });
+    hooks.emplace(insert_pos, hook_pool.create(fname, func, type, identifier, priority, filter,
+                                               std::forward<CallbackArgs>(callback_args)...));
+    return true;
+}
+
+/**
+ * @brief Takes a hook out of the registry, without publishing the removal.
+ * @note Assumes the hooks mutex is held.
+ *
+ * @param func The hooked function.
+ * @param type Which type of hook to remove.
+ * @param identifier The hook identifier.
+ * @param removed_hooks The list to move the removed hook into.
+ * @return True if successfully removed, false if no hook with the given details exists.
+ */
+bool take_hook(std::wstring_view func,
+               Type type,
+               std::wstring_view identifier,
+               std::vector<HookPtr>& removed_hooks) {
+    auto iter = registry.find(func);
+    if (iter == registry.end()) {
+        return false;
+    }
+
+    auto& hooks = iter->second.hooks.at(static_cast<size_t>(type));
+    auto hook_iter = std::ranges::find_if(
+        hooks, [identifier](auto& hook) { return hook->identifier == identifier; });
+    if (hook_iter == hooks.end()) {
+        return false;
+    }
+
+    removed_hooks.push_back(std::move(*hook_iter));
+    removed_hooks.back()->removed.store(true, std::memory_order_relaxed);
+    hooks.erase(hook_iter);
+
+    if (std::ranges::all_of(iter->second.hooks, [](auto& hooks) { return hooks.empty(); })) {
+        registry.erase(iter);
+    }
+    return true;
+}
+
 bool add_hook(std::wstring_view func,
               Type type,
               std::wstring_view identifier,
-              DLLSafeCallback&& callback) {
+              DLLSafeCallback&& callback,
+              int32_t priority,
+              const Filter& filter) {
+    // Do this before taking the lock, since it calls into unreal
     auto fname = extract_func_obj_name(func);
 
-    auto hash_idx = get_table_index(fname);
-    auto node = hooks_hash_table.at(hash_idx);
-    if (node == nullptr) {
-        // This function isn't in the hash table, can just add directly.
-        hooks_hash_table.at(hash_idx) =
-            std::make_shared<Node>(fname, func, type, identifier, std::move(callback));
+    std::vector<Retired> reclaimable{};
+    {
+        const std::scoped_lock lock(hooks_mutex);
+
+        if (!insert_hook(func, fname, type, identifier, priority, filter, std::move(callback))) {
+            return false;
+        }
+
+        publish_snapshot({});
+        reclaimable = collect_reclaimable();
+    }
+
+    refresh_hook_detours();
+    return true;
+}
+
+bool add_raw_hook(std::wstring_view func,
+                  Type type,
+                  std::wstring_view identifier,
+                  RawCallback* callback,
+                  void* ctx,
+                  RawCallbackContextDeleter* ctx_deleter,
+                  int32_t priority,
+                  const Filter& filter) {
+    // Do this before taking the lock, since it calls into unreal
+    auto fname = extract_func_obj_name(func);
+
+    std::vector<Retired> reclaimable{};
+    bool added = false;
+    {
+        const std::scoped_lock lock(hooks_mutex);
+
+        added = insert_hook(func, fname, type, identifier, priority, filter, callback, ctx,
+                            ctx_deleter);
+        if (added) {
+            publish_snapshot({});
+            reclaimable = collect_reclaimable();
+        }
+    }
+
+    if (added) {
+        refresh_hook_detours();
         return true;
     }
 
-    // Look through hash collisions
-    while (node->fname != fname) {
-        if (node->next_collision == nullptr) {
-            // We found a collision, but nothing matched our name, so add it to the end
-            node->next_collision =
-                std::make_shared<Node>(fname, func, type, identifier, std::move(callback));
-            return true;
+    // Match a std::function callback being destroyed if it couldn't be added. This may run user
+    // code, so it must be outside the lock.
+    if (ctx_deleter != nullptr) {
+        ctx_deleter(ctx);
+    }
+    return false;
+}
+
+size_t add_hooks(std::span<HookSpecView> specs) {
+    // Resolve all names up front, before taking the lock, since it calls into unreal. Batches
+    // usually have several hooks on the same function, so only look each one up once.
+    std::unordered_map<std::wstring_view, FName> fnames{};
+    for (const auto& spec : specs) {
+        const std::wstring_view func{spec.func, spec.func_size};
+        if (!fnames.contains(func)) {
+            fnames.emplace(func, extract_func_obj_name(func));
+        }
+    }
+
+    std::vector<Retired> reclaimable{};
+    size_t added = 0;
+    {
+        const std::scoped_lock lock(hooks_mutex);
+
+        for (const auto& spec : specs) {
+            const std::wstring_view func{spec.func, spec.func_size};
+            if (insert_hook(func, fnames.at(func), spec.type,
+                            {spec.identifier, spec.identifier_size}, spec.priority, spec.filter,
+                            std::move(*spec.callback))) {
+                added++;
+            }
+        }
+
+        // Publish everything in one go, so no call ever sees only half the batch
+        if (added > 0) {
+            publish_snapshot({});
+            reclaimable = collect_reclaimable();
+        }
+    }
+
+    if (added > 0) {
+        refresh_hook_detours();
+    }
+    return added;
+}
+
+bool has_hook(std::wstring_view func, Type type, std::wstring_view identifier) {
+    const std::scoped_lock lock(hooks_mutex);
+
+    auto iter = registry.find(func);
+    if (iter == registry.end()) {
+        return false;
+    }
+
+    return std::ranges::any_of(iter->second.hooks.at(static_cast<size_t>(type)),
+                               [identifier](auto& hook) { return hook->identifier == identifier; });
+}
+
+bool remove_hook(std::wstring_view func, Type type, std::wstring_view identifier) {
+    std::vector<Retired> reclaimable{};
+    {
+        const std::scoped_lock lock(hooks_mutex);
+
+        std::vector<HookPtr> removed_hooks{};
+        if (!take_hook(func, type, identifier, removed_hooks)) {
+            return false;
+        }
+
+        publish_snapshot(std::move(removed_hooks));
+        reclaimable = collect_reclaimable();
+    }
+
+    refresh_hook_detours();
+    return true;
+}
+
+size_t remove_hooks(std::span<const HookIdView> ids) {
+    std::vector<Retired> reclaimable{};
+    size_t removed = 0;
+    {
+        const std::scoped_lock lock(hooks_mutex);
+
+        std::vector<HookPtr> removed_hooks{};
+        for (const auto& id : ids) {
+            take_hook({id.func, id.func_size}, id.type, {id.identifier, id.identifier_size},
+                      removed_hooks);
+        }
+
+        removed = removed_hooks.size();
+        if (removed > 0) {
+            publish_snapshot(std::move(removed_hooks));
+            reclaimable = collect_reclaimable();
+        }
+    }
+
+    if (removed > 0) {
+        refresh_hook_detours();
+    }
+    return removed;
+}
+
+HookTableStats get_hook_table_stats(void) {
+    // Holding the lock stops the current snapshot from being swapped out and freed
+    const std::scoped_lock lock(hooks_mutex);
+
+    const auto* snapshot = current_snapshot.load(std::memory_order_acquire);
+    if (snapshot == nullptr) {
+        return {};
+    }
+
+    HookTableStats stats{};
+    for (const auto& source_table : snapshot->sources) {
+        stats.functions += source_table.nodes.size();
+        stats.names += source_table.name_count;
+        stats.capacity += source_table.table.size();
+        stats.max_probe_length = std::max(stats.max_probe_length, source_table.max_probe_length);
+        stats.total_probe_length += source_table.total_probe_length;
+    }
+    return stats;
+}
+
+#pragma region Hook Timing
+
+std::atomic<bool> hook_timing_enabled = false;
+
+/**
+ * @brief RAII class which times a single hook callback.
+ */
+class HookTimer {
+   private:
+    Hook* hook;
+    std::chrono::steady_clock::time_point start;
+
+   public:
+    explicit HookTimer(Hook* hook) : hook(hook), start(std::chrono::steady_clock::now()) {}
+    ~HookTimer() {
+        auto ns = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now()
+                                                                 - this->start)
+                .count());
+
+        this->hook->call_count.fetch_add(1, std::memory_order_relaxed);
+        this->hook->total_ns.fetch_add(ns, std::memory_order_relaxed);
+
+        auto max_ns = this->hook->max_ns.load(std::memory_order_relaxed);
+        while (ns > max_ns && !this->hook->max_ns.compare_exchange_weak(
+                                  max_ns, ns, std::memory_order_relaxed)) {}
+    }
+
+    HookTimer(const HookTimer&) = delete;
+    HookTimer(HookTimer&&) = delete;
+    HookTimer& operator=(const HookTimer&) = delete;
+    HookTimer& operator=(HookTimer&&) = delete;
+};
+
+void set_hook_timing_enabled(bool enabled) {
+    hook_timing_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool is_hook_timing_enabled(void) {
+    return hook_timing_enabled.load(std::memory_order_relaxed);
+}
+
+void reset_hook_timing(void) {
+    const std::scoped_lock lock(hooks_mutex);
+
+    for (const auto& [_, function] : registry) {
+        for (const auto& hooks : function.hooks) {
+            for (const auto& hook : hooks) {
+                hook->call_count.store(0, std::memory_order_relaxed);
+                hook->total_ns.store(0, std::memory_order_relaxed);
+                hook->max_ns.store(0, std::memory_order_relaxed);
+            }
+        }
+    }
+}
+
+void visit_hook_stats(HookStatsVisitor* visitor, void* ctx) {
+    const std::scoped_lock lock(hooks_mutex);
+
+    for (const auto& [_, function] : registry) {
+        for (const auto& hooks : function.hooks) {
+            for (const auto& hook : hooks) {
+                const HookStatsView view{
+                    .func = hook->full_name.data(),
+                    .func_size = hook->full_name.size(),
+                    .type = hook->type,
+                    .identifier = hook->identifier.data(),
+                    .identifier_size = hook->identifier.size(),
+                    .count = hook->call_count.load(std::memory_order_relaxed),
+                    .total_ns = hook->total_ns.load(std::memory_order_relaxed),
+                    .max_ns = hook->max_ns.load(std::memory_order_relaxed),
+                };
+                visitor(ctx, &view);
+            }
+        }
+    }
+}
+
+void dump_hook_stats(size_t count) {
+    auto stats = get_hook_stats();
+    std::erase_if(stats, [](auto& entry) { return entry.count == 0; });
+
+    if (stats.empty()) {
+        LOG(INFO, "No hooks have been timed");
+        return;
+    }
+    count = std::min(count, stats.size());
+
+    std::ranges::partial_sort(stats, stats.begin() + static_cast<ptrdiff_t>(count),
+                              std::ranges::greater{}, &HookStats::total_ns);
+
+    const constexpr double ns_per_us = 1000.0;
+    const constexpr double ns_per_ms = 1000000.0;
+    const constexpr std::array<std::wstring_view, HOOK_TYPE_COUNT> type_names = {
+        L"Pre", L"Post", L"PostUncond"};
+
+    LOG(INFO, "Top {} slowest hooks by total time:", count);
+    LOG(INFO, "{:>10} {:>12} {:>10} {:>10}  {:<10}  {}  {}", "Calls", "Total (ms)", "Mean (us)",
+        "Max (us)", "Type", "Identifier", "Function");
+    for (const auto& entry : std::span{stats}.first(count)) {
+        LOG(INFO, L"{:>10} {:>12.3f} {:>10.3f} {:>10.3f}  {:<10}  {}  {}", entry.count,
+            static_cast<double>(entry.total_ns) / ns_per_ms,
+            static_cast<double>(entry.total_ns) / static_cast<double>(entry.count) / ns_per_us,
+            static_cast<double>(entry.max_ns) / ns_per_us,
+            type_names.at(static_cast<size_t>(entry.type)), entry.identifier, entry.func);
+    }
+}
+
+/**
+ * @brief Callback for the hook timing console command.
+ */
+void hook_timing_command(const wchar_t* line, size_t size, size_t cmd_len) {
+    std::wstringstream stream{std::wstring{line + cmd_len, size - cmd_len}};
+    std::wstring action{};
+    stream >> action;
+
+    if (action == L"start") {
+        set_hook_timing_enabled(true);
+        LOG(INFO, "Started timing hooks");
+    } else if (action == L"stop") {
+        set_hook_timing_enabled(false);
+        LOG(INFO, "Stopped timing hooks");
+    } else if (action == L"reset") {
+        reset_hook_timing();
+        LOG(INFO, "Reset hook timing statistics");
+    } else if (action == L"dump") {
+        const constexpr size_t default_count = 20;
+        size_t count = default_count;
+        if (!(stream >> count)) {
+            count = default_count;
+        }
+        dump_hook_stats(count);
+    } else if (action == L"table") {
+        auto stats = get_hook_table_stats();
+        LOG(INFO, "Hook table: {} functions, {} names, {} slots, max probe {}, mean probe {:.3f}",
+            stats.functions, stats.names, stats.capacity, stats.max_probe_length,
+            stats.names == 0 ? 0.0
+                             : static_cast<double>(stats.total_probe_length)
+                                   / static_cast<double>(stats.names));
+    } else {
+        LOG(INFO, "Usage: unrealsdk.hook_timing start|stop|reset|dump [count]|table");
+    }
+}
+
+#pragma endregion
+
+/**
+ * @brief Finds the hooks on a given function, within the given snapshot.
+ *
+ * @param snapshot The snapshot to search through.
+ * @param source The source of the call.
+ * @param func The function which was called.
+ * @param fname The function's name.
+ * @return The function's node, or nullptr if not hooked.
+ */
+const Node* find_hooks(const Snapshot& snapshot,
+                       Source source,
+                       const UFunction* func,
+                       FName fname) {
+    const auto& source_table = snapshot.sources.at(get_source_index(source));
+
+    // The table is never full, so this will always terminate on an empty slot if not found
+    auto mask = source_table.table.size() - 1;
+    const Node* node = nullptr;
+    for (auto idx = hash_fname(fname) & mask;; idx = (idx + 1) & mask) {
+        node = source_table.table[idx];
+        if (node == nullptr) {
+            // This function isn't in the table
+            return nullptr;
+        }
+        if (node->fname == fname) {
+            break;
+        }
+    }
+
+    // Before resorting to the full path name, see if we've already resolved this exact function
+    auto& cached = resolved_hook_caches.at(get_source_index(source))
+                       .at((reinterpret_cast<uintptr_t>(func) / alignof(UFunction))
+                           % RESOLVED_HOOK_CACHE_SIZE);
+    // Since the function may have been freed and had it's memory reused since we cached it, also
+    // double check it's still got the same path
+    if (cached.func == func && cached.generation == snapshot.generation
+        && outer_chain_matches(func,
+                               std::span{cached.outer_chain}.first(cached.outer_chain_size))) {
+        return cached.node;
+    }
+
+    // At this point we need the full path name
+    auto func_name = func->get_path_name();
+
+    // Look though full function names
+    while (node != nullptr && node->full_name != func_name) {
+        // If we run out of functions, we found another function with the same fname, but nothing
+        // matches the full name - this will leave the node null
+        node = node->next_function;
+    }
+
+    if (store_outer_chain(func, cached)) {
+        cached.func = func;
+        cached.generation = snapshot.generation;
+        cached.node = node;
+    } else {
+        cached.func = nullptr;
+    }
+    return node;
+}
+
+/**
+ * @brief Checks if a call on the given object matches a hook's filter.
+ *
+ * @param filter The filter to check.
+ * @param obj The object the hooked function was called on.
+ * @return True if the hook should run.
+ */
+bool matches_filter(const Filter& filter, const UObject* obj) {
+    if (filter.object != nullptr && filter.object != obj) {
+        return false;
+    }
+    if (filter.cls != nullptr && (obj == nullptr || !obj->is_instance(filter.cls))) {
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Gets the name of a call source, as used in the call trace.
+ *
+ * @param source The call source.
+ * @return The source's name.
+ */
+std::wstring_view get_source_name(Source source) {
+    switch (source) {
+        case Source::PROCESS_EVENT:
+            return L"ProcessEvent";
+        case Source::CALL_FUNCTION:
+            return L"CallFunction";
+        default:
+            return L"Unknown";
+    }
+}
+
+#pragma region Next Call
+
+/*
+Coroutines waiting in `next_call` are queued per function, hook type, and source. Each queue with
+something waiting in it gets a single internal hook, which resumes everything waiting in it on the
+next matching call. Waiters are allocated by us, and linked together intrusively. Freed waiters are
+kept around for reuse, so once warmed up, waiting doesn't allocate.
+
+A coroutine waiting on a function in a loop almost always starts waiting again from inside the hook
+which resumed it, so rather than removing the internal hook as soon as it's queue empties, we leave
+it in place until it gets called with nothing waiting. This means straight line async code doesn't
+need to rebuild the snapshot on every call.
+
+The internal hooks are never added or removed while holding the waiters mutex, since doing so may
+free other hooks, which may call back into user code. Instead, each list tracks if it should be
+hooked, and whichever thread changes that syncs the actual hook afterwards. Since a list's hook is
+only removed from inside itself, that removal is also deferred until the call's finished running
+all of it's hooks. This means we never call out to anything while holding the mutex.
+
+Waiters are resumed outside of the waiters mutex. Since we own the waiter, rather than the
+coroutine, the awaitable being destroyed mid resume can't free it out from under us - it just gets
+marked, and we free it once the resume returns. Destroying it from inside the resume itself (e.g.
+the coroutine continuing past the await) is the normal case. Destroying it from another thread
+while it's running would mean destroying a running coroutine, which we can't make safe, so we just
+log an error.
+*/
+
+const constexpr auto FILTER_SOURCE_COUNT = static_cast<size_t>(Source::CALL_FUNCTION) + 1;
+
+// Must be unique per source, since they may all be on the same function and type
+const constexpr std::array<std::wstring_view, FILTER_SOURCE_COUNT> NEXT_CALL_IDENTIFIERS = {
+    L"unrealsdk.next_call",
+    L"unrealsdk.next_call.ProcessEvent",
+    L"unrealsdk.next_call.CallFunction",
+};
+
+struct WaiterQueue {
+    NextCallWaiter* head = nullptr;
+    NextCallWaiter* tail = nullptr;
+
+    /**
+     * @brief Pushes a waiter onto the back of the queue.
+     *
+     * @param waiter The waiter to push.
+     */
+    void push(NextCallWaiter* waiter);
+
+    /**
+     * @brief Pops the waiter off the front of the queue.
+     *
+     * @return The popped waiter, or nullptr if the queue was empty.
+     */
+    NextCallWaiter* pop(void);
+
+    /**
+     * @brief Removes a waiter from anywhere in the queue.
+     *
+     * @param waiter The waiter to remove.
+     */
+    void remove(NextCallWaiter* waiter);
+};
+
+}  // namespace
+
+struct NextCallWaiter {
+    Type type;
+    Filter filter;
+
+    // Resumes the waiting coroutine. Always compiled in the same dll as the coroutine.
+    void (*resume)(void* handle);
+    // The address of the waiting coroutine's handle.
+    void* handle;
+
+    // The details of the call which resumed the coroutine. Only valid until it next suspends.
+    Details* details;
+
+    // The queue this waiter is currently in, or null if not waiting.
+    WaiterQueue* queue;
+    // The next waiter in the queue, or in the free list.
+    NextCallWaiter* next;
+
+    // Set while the coroutine's being resumed, during which the waiter must not be freed
+    bool resuming;
+    std::thread::id resuming_thread;
+    // Set if the awaitable was destroyed while resuming, the waiter gets freed once it finishes
+    bool destroyed;
+};
+
+namespace {
+
+void WaiterQueue::push(NextCallWaiter* waiter) {
+    waiter->queue = this;
+    waiter->next = nullptr;
+    if (this->tail == nullptr) {
+        this->head = waiter;
+    } else {
+        this->tail->next = waiter;
+    }
+    this->tail = waiter;
+}
+
+NextCallWaiter* WaiterQueue::pop(void) {
+    auto* waiter = this->head;
+    if (waiter != nullptr) {
+        this->head = waiter->next;
+        if (this->head == nullptr) {
+            this->tail = nullptr;
+        }
+        waiter->queue = nullptr;
+    }
+    return waiter;
+}
+
+void WaiterQueue::remove(NextCallWaiter* waiter) {
+    NextCallWaiter* prev = nullptr;
+    for (auto* current = this->head; current != nullptr; current = current->next) {
+        if (current != waiter) {
+            prev = current;
+            continue;
+        }
+
+        (prev == nullptr ? this->head : prev->next) = current->next;
+        if (this->tail == current) {
+            this->tail = prev;
+        }
+        waiter->queue = nullptr;
+        return;
+    }
+}
+
+struct WaiterList {
+    std::wstring func;
+    Type type;
+    Source source;
+    WaiterQueue queue;
+    // If the internal hook should currently be added
+    bool should_hook = false;
+    // If the internal hook actually is currently added
+    bool hooked = false;
+    // If a thread is currently adding/removing the internal hook
+    bool syncing = false;
+};
+
+std::mutex waiters_mutex{};
+
+// Freed waiters, linked through their next pointers. Never actually freed.
+NextCallWaiter* free_waiters = nullptr;
+
+// Lists are never freed, so that the internal hooks can safely point at them
+utils::StringViewMap<std::wstring,
+                     std::array<std::unique_ptr<WaiterList>, HOOK_TYPE_COUNT * FILTER_SOURCE_COUNT>>
+    waiter_lists{};
+
+// Lists whose own hook decided to remove itself, which still need syncing once it's finished
+thread_local std::vector<WaiterList*> pending_waiter_syncs{};
+
+/**
+ * @brief Frees a waiter, returning it to the free list.
+ * @note Must be called while holding the waiters mutex.
+ *
+ * @param waiter The waiter to free.
+ */
+void free_waiter(NextCallWaiter* waiter) {
+    waiter->next = free_waiters;
+    free_waiters = waiter;
+}
+
+/**
+ * @brief Marks that a waiter has finished being resumed, freeing it if it was destroyed meanwhile.
+ *
+ * @param waiter The waiter which was resumed.
+ */
+void finish_resuming(NextCallWaiter* waiter) {
+    const std::scoped_lock lock(waiters_mutex);
+    waiter->resuming = false;
+    if (waiter->destroyed) {
+        free_waiter(waiter);
+    }
+}
+
+/**
+ * @brief Resumes all coroutines waiting on a call.
+ *
+ * @param list The list of waiters on the called function.
+ * @param details The call's details.
+ * @return False, waiters can't block execution.
+ */
+bool resume_waiters(WaiterList& list, Details& details) {
+    WaiterQueue ready{};
+    {
+        const std::scoped_lock lock(waiters_mutex);
+        if (list.queue.head == nullptr) {
+            // Nothing's waited on this since we were last called, so we're no longer needed. We're
+            // still running though, so leave actually removing ourselves until the call's done.
+            list.should_hook = false;
+            if (std::ranges::find(pending_waiter_syncs, &list) == pending_waiter_syncs.end()) {
+                pending_waiter_syncs.push_back(&list);
+            }
+            return false;
         }
-        node = node->next_collision;
-    }
 
-    // Look though full function names
-    while (node->full_name != func) {
-        if (node->next_function == nullptr) {
-            // We found another function with the same fname, but nothing matches the full name
-            node->next_function =
-                std::make_shared<Node>(fname, func, type, identifier, std::move(callback));
-            return true;
+        WaiterQueue waiting{};
+        std::swap(waiting, list.queue);
+        while (auto* waiter = waiting.pop()) {
+            (matches_filter(waiter->filter, details.obj) ? ready : list.queue).push(waiter);
         }
-        node = node->next_function;
     }
 
-    // Look through hook types
-    while (node->type != type) {
-        if (node->next_type == nullptr) {
-            // We found the right function, but it doesn't have any hooks of this type yet
-            node->next_type =
-                std::make_shared<Node>(fname, func, type, identifier, std::move(callback));
-            return true;
+    // Resume each waiter outside of the lock, since they're free to start waiting again. They may
+    // also destroy each other, so the ready queue must stay consistent the whole time.
+    while (true) {
+        NextCallWaiter* waiter{};
+        {
+            const std::scoped_lock lock(waiters_mutex);
+            waiter = ready.pop();
+            if (waiter == nullptr) {
+                break;
+            }
+            waiter->resuming = true;
+            waiter->resuming_thread = std::this_thread::get_id();
+            waiter->details = &details;
         }
-        node = node->next_type;
-    }
 
-    // Look through all remaining hooks to see if we can match the identifier
-    while (node->identifier != identifier) {
-        if (node->next_in_collection == nullptr) {
-            // Didn't find a matching identifier, add our new hook at the end
-            node->next_in_collection =
-                std::make_shared<Node>(fname, func, type, identifier, std::move(callback));
+        try {
+            waiter->resume(waiter->handle);
+        } catch (const std::exception& ex) {
+            LOG(ERROR, "An exception occurred while resuming a coroutine waiting on a call");
+            LOG(ERROR, L"Function: {}", list.func);
+            LOG(ERROR, "Exception: {}", ex.what());
+        } catch (...) {
+            finish_resuming(waiter);
+            throw;
         }
-        node = node->next_in_collection;
+        finish_resuming(waiter);
     }
 
-    // We already have this identifier, can't insert
     return false;
 }
 
-bool has_hook(std::wstring_view func, Type type, std::wstring_view identifier) {
-    auto fname = extract_func_obj_name(func);
-
-    auto hash_idx = get_table_index(fname);
-    auto node = hooks_hash_table.at(hash_idx);
-    if (node == nullptr) {
-        // This function isn't even in the hash table
-        return false;
-    }
-
-    // Look through hash collisions
-    while (node->fname != fname) {
-        if (node->next_collision == nullptr) {
-            // We found a collision, but nothing matched our name
-            return false;
+/**
+ * @brief Adds or removes a list's internal hook, to match if it should be hooked.
+ * @note Must not be called while holding the waiters mutex.
+ * @note If another call is already syncing the list, leaves it to them.
+ *
+ * @param list The list to sync.
+ */
+void sync_waiter_hook(WaiterList& list) {
+    {
+        const std::scoped_lock lock(waiters_mutex);
+        if (list.syncing) {
+            return;
         }
-        node = node->next_collision;
+        list.syncing = true;
     }
 
-    // Look though full function names
-    while (node->full_name != func) {
-        if (node->next_function == nullptr) {
-            // We found another function with the same fname, but nothing matches the full name
-            return false;
+    auto identifier = NEXT_CALL_IDENTIFIERS.at(static_cast<size_t>(list.source));
+    try {
+        // Keep going until it's stable, since it may be changed again while we're (un)hooking
+        while (true) {
+            bool should_hook{};
+            {
+                const std::scoped_lock lock(waiters_mutex);
+                if (list.should_hook == list.hooked) {
+                    list.syncing = false;
+                    return;
+                }
+                should_hook = list.should_hook;
+            }
+
+            if (should_hook) {
+                // Run after all normal hooks, so they can't see anything a waiter might change
+                DLLSafeCallback callback{
+                    [&list](Details& details) { return resume_waiters(list, details); }};
+                add_hook(list.func, list.type, identifier, std::move(callback),
+                         std::numeric_limits<int32_t>::min(), Filter{.source = list.source});
+            } else {
+                impl::remove_hook(list.func, list.type, identifier);
+            }
+
+            const std::scoped_lock lock(waiters_mutex);
+            list.hooked = should_hook;
         }
-        node = node->next_function;
+    } catch (...) {
+        const std::scoped_lock lock(waiters_mutex);
+        list.syncing = false;
+        throw;
     }
+}
 
-    // Look through hook types
-    while (node->type != type) {
-        if (node->next_type == nullptr) {
-            // We found the right function, but it doesn't have any hooks of this type
-            return false;
+/**
+ * @brief Syncs the hooks of any lists which were deferred while running hooks on this thread.
+ * @note Must be called once all hooks on this thread have finished.
+ */
+void sync_pending_waiter_hooks(void) {
+    while (!pending_waiter_syncs.empty()) {
+        auto* list = pending_waiter_syncs.back();
+        pending_waiter_syncs.pop_back();
+        try {
+            sync_waiter_hook(*list);
+        } catch (const std::exception& ex) {
+            LOG(ERROR, L"Failed to remove the internal next call hook on {}", list->func);
+            LOG(ERROR, "Exception: {}", ex.what());
         }
-        node = node->next_type;
     }
+}
 
-    // Look through all remaining hooks to see if we can match the identifier
-    while (node->identifier != identifier) {
-        if (node->next_in_collection == nullptr) {
-            // Didn't find a matching identifier
-            return false;
+/**
+ * @brief Creates a new waiter.
+ *
+ * @param type When to resume, relative to the function running.
+ * @param filter A filter restricting which calls resume the coroutine.
+ * @return The new waiter.
+ */
+NextCallWaiter* create_next_call_waiter(Type type, const Filter& filter) {
+    NextCallWaiter* waiter = nullptr;
+    {
+        const std::scoped_lock lock(waiters_mutex);
+        waiter = free_waiters;
+        if (waiter != nullptr) {
+            free_waiters = waiter->next;
         }
-        node = node->next_in_collection;
+    }
+    if (waiter == nullptr) {
+        // NOLINTNEXTLINE(cppcoreguidelines-owning-memory)
+        waiter = new NextCallWaiter{};
     }
 
-    return true;
+    *waiter = {
+        .type = type,
+        .filter = filter,
+        .resume = nullptr,
+        .handle = nullptr,
+        .details = nullptr,
+        .queue = nullptr,
+        .next = nullptr,
+        .resuming = false,
+        .resuming_thread = {},
+        .destroyed = false,
+    };
+    return waiter;
 }
 
-bool remove_hook(std::wstring_view func, Type type, std::wstring_view identifier) {
-    auto fname = extract_func_obj_name(func);
-
-    auto hash_idx = get_table_index(fname);
-    auto node = hooks_hash_table.at(hash_idx);
-    if (node == nullptr) {
-        // This function isn't even in the hash table
-        return false;
-    }
-
-    // Look through hash collisions
-    decltype(node) prev_collision = nullptr;
-    while (node->fname != fname) {
-        if (node->next_collision == nullptr) {
-            // We found a collision, but nothing matched our name
-            return false;
+/**
+ * @brief Starts a coroutine waiting on the next call to a function.
+ *
+ * @param func The function to wait on.
+ * @param waiter The waiter to add.
+ * @param resume Resumes the waiting coroutine.
+ * @param handle The address of the waiting coroutine's handle.
+ */
+void add_next_call_waiter(std::wstring_view func,
+                          NextCallWaiter* waiter,
+                          void (*resume)(void* handle),
+                          void* handle) {
+    WaiterList* list{};
+    {
+        const std::scoped_lock lock(waiters_mutex);
+
+        auto iter = waiter_lists.find(func);
+        if (iter == waiter_lists.end()) {
+            iter = waiter_lists.try_emplace(std::wstring{func}).first;
         }
-        prev_collision = node;
-        node = node->next_collision;
-    }
 
-    // Look though full function names
-    decltype(node) prev_function = nullptr;
-    while (node->full_name != func) {
-        if (node->next_function == nullptr) {
-            // We found another function with the same fname, but nothing matches the full name
-            return false;
+        auto source = waiter->filter.source;
+        auto& list_ptr = iter->second.at((static_cast<size_t>(waiter->type) * FILTER_SOURCE_COUNT)
+                                         + static_cast<size_t>(source));
+        if (list_ptr == nullptr) {
+            list_ptr = std::make_unique<WaiterList>(WaiterList{
+                .func = iter->first, .type = waiter->type, .source = source, .queue = {}});
         }
-        prev_function = node;
-        node = node->next_function;
-    }
+        list = list_ptr.get();
 
-    // Look through hook types
-    decltype(node) prev_type = nullptr;
-    while (node->type != type) {
-        if (node->next_type == nullptr) {
-            // We found the right function, but it doesn't have any hooks of this type
-            return false;
-        }
-        prev_type = node;
-        node = node->next_type;
-    }
+        waiter->resume = resume;
+        waiter->handle = handle;
+        list->queue.push(waiter);
 
-    // Look through all remaining hooks to see if we can match the identifier
-    decltype(node) prev_in_collection = nullptr;
-    while (node->identifier != identifier) {
-        if (node->next_in_collection == nullptr) {
-            // Didn't find a matching identifier
-            return false;
+        if (list->should_hook && list->hooked) {
+            return;
         }
-        prev_in_collection = node;
-        node = node->next_in_collection;
+        list->should_hook = true;
     }
 
-    /*
-    We found a matching hook - 'node' is pointing at it.
-
-    Consider the following diagram the diagram from above:
-
-    Collision  | [A] -----------------------------> [F]
-               |  :                                  :
-    Function   | [A] ---------------> [D]           [F]
-               |  :                    :             :
-    Type       | [A]                   :            [F] --------> [H]
-               |  :                    :             :             :
-    Collection | [A] -> [B] -> [C]    [D] -> [E]    [F] -> [G]    [H]
-
-    Lets say we want to remove B, D, and F. The new layout we need is:
+    sync_waiter_hook(*list);
+}
 
-    Collision  | [A] ------------------------------------> [G]
-               |  :                                         :
-    Function   | [A] ----------------------> [E]            :
-               |  :                           :             :
-    Type       | [A]                          :            [G] -> [H]
-               |  :                           :             :      :
-    Collection | [A] --------> [C]           [E]           [G]    [H]
+/**
+ * @brief Destroys a waiter, cancelling it if it's still waiting.
+ * @note If the waiter's currently being resumed, it's freed once the resume finishes.
+ *
+ * @param waiter The waiter to destroy.
+ */
+void destroy_next_call_waiter(NextCallWaiter* waiter) {
+    const std::scoped_lock lock(waiters_mutex);
+    if (waiter->queue != nullptr) {
+        waiter->queue->remove(waiter);
+    }
 
-    Removing B is easy, we simply set A->next_in_collection = C to bypass it.
+    if (!waiter->resuming) {
+        free_waiter(waiter);
+        return;
+    }
 
-    For D, we need to work bottom up. If our node is the head of the list, we need to promote our
-    next node up a layer. If our node is also the head of the above layer, we need to recurse
-    another layer up. So since D is the head of both the collection and type linked lists, we move
-    up to the function linked list, and need to set A->next_function = E.
+    if (waiter->resuming_thread != std::this_thread::get_id()) {
+        LOG(ERROR, "Tried to cancel a coroutine waiting on a call while it's being resumed on "
+                   "another thread! Coroutines must not be destroyed while running.");
+    }
+    waiter->destroyed = true;
+}
 
-    F exposes a further complication on top of D, since it was pointing at multiple other nodes. As
-    part of promoting a node up a layer, we need to insert it into that layer's linked list - that's
-    how we keep then link to H. In D's case, these were all null.
+#pragma endregion
 
-    Since only the heads of the lower-layer lists are used in the higher layer ones, as soon as we
-    come across a layer where we're not the head, we must be done, the lower layer nodes cannot have
-    other references to upper ones.
-    */
+}  // namespace
 
-    if (prev_in_collection != nullptr) {
-        prev_in_collection->next_in_collection = node->next_in_collection;
-        return true;
-    }
-    if (node->next_in_collection) {
-        node->next_in_collection->next_type = node->next_type;
-        node->next_type = node->next_in_collection;
-    }
+NodeHandle::NodeHandle(const Node* node) : node(node) {}
 
-    if (prev_type != nullptr) {
-        prev_type->next_type = node->next_type;
-        return true;
-    }
-    if (node->next_type != nullptr) {
-        node->next_type->next_function = node->next_function;
-        node->next_function = node->next_type;
-    }
+NodeHandle::NodeHandle(NodeHandle&& other) noexcept : node(std::exchange(other.node, nullptr)) {}
 
-    if (prev_function != nullptr) {
-        prev_function->next_function = node->next_function;
-        return true;
-    }
-    if (node->next_function != nullptr) {
-        node->next_function->next_collision = node->next_collision;
-        node->next_collision = node->next_function;
-    }
+NodeHandle::~NodeHandle() {
+    if (this->node != nullptr) {
+        exit_read_section();
 
-    if (prev_collision != nullptr) {
-        prev_collision->next_collision = node->next_collision;
-        return true;
+        // Now that all hooks on this thread have finished, apply any changes they deferred
+        if (thread_reader.depth == 0) {
+            sync_pending_waiter_hooks();
+            if (hook_detours_refresh_pending.load(std::memory_order_acquire)) {
+                refresh_hook_detours();
+            }
+        }
     }
-    // There's no higher layer linked list left. If we have following collision entries, set the
-    // hash table to them. If we don't, we want to null it anyway.
-    hooks_hash_table.at(hash_idx) = node->next_collision;
-    return true;
 }
 
-}  // namespace
-
-std::shared_ptr<Node> preprocess_hook(std::wstring_view source,
-                                      const UFunction* func,
-                                      const UObject* obj) {
+NodeHandle preprocess_hook(Source source, const UFunction* func, const UObject* obj) {
     if (should_inject_next_call) {
         should_inject_next_call = false;
-        return nullptr;
+        return NodeHandle{nullptr};
     }
 
-    // Want to delay filling this, but if we're logging all calls we need it straight away
-    std::wstring func_name{};
-
-    if (should_log_all_calls) {
-        // Extra safety check
-        if (log_all_calls_stream.is_open()) {
-            func_name = func->get_path_name();
-            auto obj_name = obj->get_path_name();
-
-            const std::scoped_lock lock(log_all_calls_stream_mutex);
-            log_all_calls_stream << source << L'\t' << func_name << L'\t' << obj_name << L'\n';
-        }
+    if (should_log_all_calls.load(std::memory_order_relaxed)) {
+        call_trace::record(get_source_name(source), func, obj);
     }
 
     auto fname = func->Name();
-
-    auto hash_idx = get_table_index(fname);
-    auto node = hooks_hash_table.at(hash_idx);
-    if (node == nullptr) {
-        // This function isn't even in the hash table
-        return nullptr;
+    if (!might_be_hooked(source, fname)) {
+        return NodeHandle{nullptr};
     }
 
-    // Look through hash collisions
-    while (node->fname != fname) {
-        if (node->next_collision == nullptr) {
-            // We found a collision, but nothing matched our name
-            return nullptr;
-        }
-        node = node->next_collision;
-    }
+    enter_read_section();
 
-    // At this point we need the full path name
-    if (!should_log_all_calls) {
-        func_name = func->get_path_name();
+    const auto* snapshot = current_snapshot.load(std::memory_order_acquire);
+    const auto* node = snapshot == nullptr ? nullptr : find_hooks(*snapshot, source, func, fname);
+    if (node == nullptr) {
+        exit_read_section();
+        return NodeHandle{nullptr};
     }
 
-    // Look though full function names
-    while (node->full_name != func_name) {
-        if (node->next_function == nullptr) {
-            // We found another function with the same fname, but nothing matches the full name
-            return nullptr;
-        }
-        node = node->next_function;
+    if (node->all_filtered
+        && std::ranges::none_of(node->hooks, [obj](auto& hooks) {
+               return std::ranges::any_of(
+                   hooks, [obj](const Hook* hook) { return matches_filter(hook->filter, obj); });
+           })) {
+        exit_read_section();
+        return NodeHandle{nullptr};
     }
 
     // Break off at this point - we know we have hooks on this function, so the hook processing will
-    // need to start extracting args.
-    return node;
+    // need to start extracting args. The handle keeps us in the read section until it's done.
+    return NodeHandle{node};
 }
 
-bool has_post_hooks(std::shared_ptr<Node> node) {
-    // We got the node from preprocess_hook, it's pointing to the start of the types linked list
-    for (; node != nullptr; node = node->next_type) {
-        if (node->type == Type::POST || node->type == Type::POST_UNCONDITIONAL) {
-            return true;
-        }
-    }
-    return false;
+bool has_post_hooks(const Node* node) {
+    return !node->hooks.at(static_cast<size_t>(Type::POST)).empty()
+           || !node->hooks.at(static_cast<size_t>(Type::POST_UNCONDITIONAL)).empty();
 }
 
-bool run_hooks_of_type(std::shared_ptr<Node> node, Type type, Details& hook) {
-    // We got the node from preprocess_hook, it's pointing to the start of the types linked list
+bool run_hooks_of_type(const Node* node, Type type, Details& hook) {
+    // We got the node from preprocess_hook, so we just need to run all hooks of the right type
+    const bool should_time = hook_timing_enabled.load(std::memory_order_relaxed);
 
-    // Look through hook types
-    while (node->type != type) {
-        if (node->next_type == nullptr) {
-            // No hooks of this type - return false to not block
-            return false;
+    bool ret = false;
+    for (auto* hook_entry : node->hooks.at(static_cast<size_t>(type))) {
+        if (hook_entry->removed.load(std::memory_order_relaxed)) {
+            continue;
+        }
+        if (!matches_filter(hook_entry->filter, hook.obj)) {
+            continue;
         }
-        node = node->next_type;
-    }
 
-    // We've got the final list of hooks, run them all
-    bool ret = false;
-    for (; node != nullptr; node = node->next_in_collection) {
         try {
-            ret |= node->callback(hook);
+            if (should_time) {
+                const HookTimer timer{hook_entry};
+                ret |= hook_entry->raw_callback(&hook, hook_entry->ctx);
+            } else {
+                ret |= hook_entry->raw_callback(&hook, hook_entry->ctx);
+            }
         } catch (const std::exception& ex) {
             LOG(ERROR, "An exception occurred during hook processing");
             LOG(ERROR, L"Function: {}", hook.func.func->get_path_name());
@@ -511,6 +1930,30 @@ bool run_hooks_of_type(std::shared_ptr<Node> node, Type type, Details& hook) {
     return ret;
 }
 
+void register_hook_detour(uintptr_t addr) {
+    {
+        const std::scoped_lock lock(detours_mutex);
+        hook_detours.push_back(addr);
+        if (!hook_detours_enabled) {
+            // Make sure this one matches the rest, refreshing will re-enable them all if needed
+            auto status = MH_DisableHook(reinterpret_cast<LPVOID>(addr));
+            if (status != MH_OK) {
+                LOG(ERROR, "Failed to disable hook detour at {:p}; With error: '{}'",
+                    reinterpret_cast<void*>(addr), MH_StatusToString(status));
+            }
+        }
+    }
+    refresh_hook_detours();
+}
+
+void update_hook_detours(void) {
+    refresh_hook_detours();
+}
+
+void register_commands(void) {
+    commands::add_command(L"unrealsdk.hook_timing", &hook_timing_command);
+}
+
 }  // namespace impl
 #endif
 #pragma endregion
@@ -562,21 +2005,97 @@ UNREALSDK_CAPI(bool,
                const wchar_t* identifier,
                size_t identifier_size,
                DLLSafeCallback&& callback) {
+    // Kept with it's original signature for anything built against an older sdk
+    return impl::add_hook({func, func_size}, type, {identifier, identifier_size},
+                          std::move(callback), 0, {});
+}
+#endif
+
+#ifdef UNREALSDK_SHARED
+UNREALSDK_CAPI(bool,
+               add_hook_ex,
+               const wchar_t* func,
+               size_t func_size,
+               Type type,
+               const wchar_t* identifier,
+               size_t identifier_size,
+               DLLSafeCallback&& callback,
+               int32_t priority,
+               const Filter* filter);
+#endif
+#ifndef UNREALSDK_IMPORTING
+UNREALSDK_CAPI(bool,
+               add_hook_ex,
+               const wchar_t* func,
+               size_t func_size,
+               Type type,
+               const wchar_t* identifier,
+               size_t identifier_size,
+               DLLSafeCallback&& callback,
+               int32_t priority,
+               const Filter* filter) {
     return impl::add_hook({func, func_size}, type, {identifier, identifier_size},
-                          std::move(callback));
+                          std::move(callback), priority, *filter);
 }
 #endif
 
 bool add_hook(std::wstring_view func,
               Type type,
               std::wstring_view identifier,
-              const Callback& callback) {
+              const Callback& callback,
+              int32_t priority,
+              const Filter& filter) {
     // NOLINTBEGIN(cppcoreguidelines-owning-memory)
-    return UNREALSDK_MANGLE(add_hook)(func.data(), func.size(), type, identifier.data(),
-                                      identifier.size(), {callback});
+    return UNREALSDK_MANGLE(add_hook_ex)(func.data(), func.size(), type, identifier.data(),
+                                         identifier.size(), {callback}, priority, &filter);
     // NOLINTEND(cppcoreguidelines-owning-memory)
 }
 
+#ifdef UNREALSDK_SHARED
+UNREALSDK_CAPI(bool,
+               add_raw_hook,
+               const wchar_t* func,
+               size_t func_size,
+               Type type,
+               const wchar_t* identifier,
+               size_t identifier_size,
+               RawCallback* callback,
+               void* ctx,
+               RawCallbackContextDeleter* ctx_deleter,
+               int32_t priority,
+               const Filter* filter);
+#endif
+#ifndef UNREALSDK_IMPORTING
+UNREALSDK_CAPI(bool,
+               add_raw_hook,
+               const wchar_t* func,
+               size_t func_size,
+               Type type,
+               const wchar_t* identifier,
+               size_t identifier_size,
+               RawCallback* callback,
+               void* ctx,
+               RawCallbackContextDeleter* ctx_deleter,
+               int32_t priority,
+               const Filter* filter) {
+    return impl::add_raw_hook({func, func_size}, type, {identifier, identifier_size}, callback, ctx,
+                              ctx_deleter, priority, *filter);
+}
+#endif
+
+bool add_raw_hook(std::wstring_view func,
+                  Type type,
+                  std::wstring_view identifier,
+                  RawCallback* callback,
+                  void* ctx,
+                  RawCallbackContextDeleter* ctx_deleter,
+                  int32_t priority,
+                  const Filter& filter) {
+    return UNREALSDK_MANGLE(add_raw_hook)(func.data(), func.size(), type, identifier.data(),
+                                          identifier.size(), callback, ctx, ctx_deleter, priority,
+                                          &filter);
+}
+
 #ifdef UNREALSDK_SHARED
 UNREALSDK_CAPI(bool,
                has_hook,
@@ -631,6 +2150,236 @@ bool remove_hook(std::wstring_view func, Type type, std::wstring_view identifier
                                          identifier.size());
 }
 
+#ifdef UNREALSDK_SHARED
+UNREALSDK_CAPI(size_t, add_hooks, HookSpecView* specs, size_t count);
+#endif
+#ifndef UNREALSDK_IMPORTING
+UNREALSDK_CAPI(size_t, add_hooks, HookSpecView* specs, size_t count) {
+    return impl::add_hooks({specs, count});
+}
+#endif
+
+size_t add_hooks(std::span<const HookSpec> hooks) {
+    // NOLINTBEGIN(cppcoreguidelines-owning-memory)
+    std::vector<DLLSafeCallback> callbacks{};
+    callbacks.reserve(hooks.size());
+    std::vector<HookSpecView> specs{};
+    specs.reserve(hooks.size());
+
+    for (const auto& hook : hooks) {
+        specs.push_back({
+            .func = hook.func.data(),
+            .func_size = hook.func.size(),
+            .type = hook.type,
+            .identifier = hook.identifier.data(),
+            .identifier_size = hook.identifier.size(),
+            .callback = &callbacks.emplace_back(hook.callback),
+            .priority = hook.priority,
+            .filter = hook.filter,
+        });
+    }
+
+    return UNREALSDK_MANGLE(add_hooks)(specs.data(), specs.size());
+    // NOLINTEND(cppcoreguidelines-owning-memory)
+}
+
+#ifdef UNREALSDK_SHARED
+UNREALSDK_CAPI(size_t, remove_hooks, const HookIdView* ids, size_t count);
+#endif
+#ifndef UNREALSDK_IMPORTING
+UNREALSDK_CAPI(size_t, remove_hooks, const HookIdView* ids, size_t count) {
+    return impl::remove_hooks({ids, count});
+}
+#endif
+
+size_t remove_hooks(std::span<const HookId> hooks) {
+    std::vector<HookIdView> ids{};
+    ids.reserve(hooks.size());
+    std::ranges::transform(hooks, std::back_inserter(ids), [](const HookId& hook) {
+        return HookIdView{
+            .func = hook.func.data(),
+            .func_size = hook.func.size(),
+            .type = hook.type,
+            .identifier = hook.identifier.data(),
+            .identifier_size = hook.identifier.size(),
+        };
+    });
+
+    return UNREALSDK_MANGLE(remove_hooks)(ids.data(), ids.size());
+}
+
+#ifdef UNREALSDK_SHARED
+UNREALSDK_CAPI([[nodiscard]] impl::NextCallWaiter*,
+               create_next_call_waiter,
+               Type type,
+               const Filter* filter);
+#endif
+#ifndef UNREALSDK_IMPORTING
+UNREALSDK_CAPI([[nodiscard]] impl::NextCallWaiter*,
+               create_next_call_waiter,
+               Type type,
+               const Filter* filter) {
+    return impl::create_next_call_waiter(type, *filter);
+}
+#endif
+
+#ifdef UNREALSDK_SHARED
+UNREALSDK_CAPI(void,
+               add_next_call_waiter,
+               const wchar_t* func,
+               size_t func_size,
+               impl::NextCallWaiter* waiter,
+               void (*resume)(void* handle),
+               void* handle);
+#endif
+#ifndef UNREALSDK_IMPORTING
+UNREALSDK_CAPI(void,
+               add_next_call_waiter,
+               const wchar_t* func,
+               size_t func_size,
+               impl::NextCallWaiter* waiter,
+               void (*resume)(void* handle),
+               void* handle) {
+    impl::add_next_call_waiter({func, func_size}, waiter, resume, handle);
+}
+#endif
+
+#ifdef UNREALSDK_SHARED
+UNREALSDK_CAPI(void, destroy_next_call_waiter, impl::NextCallWaiter* waiter);
+#endif
+#ifndef UNREALSDK_IMPORTING
+UNREALSDK_CAPI(void, destroy_next_call_waiter, impl::NextCallWaiter* waiter) {
+    impl::destroy_next_call_waiter(waiter);
+}
+#endif
+
+#ifdef UNREALSDK_SHARED
+UNREALSDK_CAPI([[nodiscard]] Details*,
+               get_next_call_details,
+               const impl::NextCallWaiter* waiter);
+#endif
+#ifndef UNREALSDK_IMPORTING
+UNREALSDK_CAPI([[nodiscard]] Details*,
+               get_next_call_details,
+               const impl::NextCallWaiter* waiter) {
+    return waiter->details;
+}
+#endif
+
+NextCall::NextCall(std::wstring_view func, Type type, const Filter& filter)
+    : func(func), waiter(UNREALSDK_MANGLE(create_next_call_waiter)(type, &filter)) {}
+
+NextCall::~NextCall() {
+    UNREALSDK_MANGLE(destroy_next_call_waiter)(this->waiter);
+}
+
+void NextCall::await_suspend(std::coroutine_handle<> handle) {
+    // Both of these must be compiled on our side of the dll boundary, since we can't rely on
+    // coroutine handles having the same layout on the other
+    auto resume = [](void* address) { std::coroutine_handle<>::from_address(address).resume(); };
+
+    // May be resumed on another thread as soon as this is added, so mustn't touch anything after
+    UNREALSDK_MANGLE(add_next_call_waiter)(this->func.data(), this->func.size(), this->waiter,
+                                           resume, handle.address());
+}
+
+Details& NextCall::await_resume(void) const noexcept {
+    return *UNREALSDK_MANGLE(get_next_call_details)(this->waiter);
+}
+
+NextCall next_call(std::wstring_view func, Type type, const Filter& filter) {
+    return {func, type, filter};
+}
+
+#ifdef UNREALSDK_SHARED
+UNREALSDK_CAPI(void, get_hook_table_stats, HookTableStats* stats);
+#endif
+#ifndef UNREALSDK_IMPORTING
+UNREALSDK_CAPI(void, get_hook_table_stats, HookTableStats* stats) {
+    *stats = impl::get_hook_table_stats();
+}
+#endif
+
+HookTableStats get_hook_table_stats(void) {
+    HookTableStats stats{};
+    UNREALSDK_MANGLE(get_hook_table_stats)(&stats);
+    return stats;
+}
+
+#ifdef UNREALSDK_SHARED
+UNREALSDK_CAPI(void, set_hook_timing_enabled, bool enabled);
+#endif
+#ifndef UNREALSDK_IMPORTING
+UNREALSDK_CAPI(void, set_hook_timing_enabled, bool enabled) {
+    impl::set_hook_timing_enabled(enabled);
+}
+#endif
+void set_hook_timing_enabled(bool enabled) {
+    UNREALSDK_MANGLE(set_hook_timing_enabled)(enabled);
+}
+
+#ifdef UNREALSDK_SHARED
+UNREALSDK_CAPI([[nodiscard]] bool, is_hook_timing_enabled);
+#endif
+#ifndef UNREALSDK_IMPORTING
+UNREALSDK_CAPI([[nodiscard]] bool, is_hook_timing_enabled) {
+    return impl::is_hook_timing_enabled();
+}
+#endif
+bool is_hook_timing_enabled(void) {
+    return UNREALSDK_MANGLE(is_hook_timing_enabled)();
+}
+
+#ifdef UNREALSDK_SHARED
+UNREALSDK_CAPI(void, reset_hook_timing);
+#endif
+#ifndef UNREALSDK_IMPORTING
+UNREALSDK_CAPI(void, reset_hook_timing) {
+    impl::reset_hook_timing();
+}
+#endif
+void reset_hook_timing(void) {
+    UNREALSDK_MANGLE(reset_hook_timing)();
+}
+
+#ifdef UNREALSDK_SHARED
+UNREALSDK_CAPI(void, visit_hook_stats, HookStatsVisitor* visitor, void* ctx);
+#endif
+#ifndef UNREALSDK_IMPORTING
+UNREALSDK_CAPI(void, visit_hook_stats, HookStatsVisitor* visitor, void* ctx) {
+    impl::visit_hook_stats(visitor, ctx);
+}
+#endif
+std::vector<HookStats> get_hook_stats(void) {
+    std::vector<HookStats> stats{};
+    // Copy the strings on our side of the dll boundary
+    UNREALSDK_MANGLE(visit_hook_stats)(
+        [](void* ctx, const HookStatsView* view) {
+            static_cast<std::vector<HookStats>*>(ctx)->push_back({
+                .func = {view->func, view->func_size},
+                .type = view->type,
+                .identifier = {view->identifier, view->identifier_size},
+                .count = view->count,
+                .total_ns = view->total_ns,
+                .max_ns = view->max_ns,
+            });
+        },
+        &stats);
+    return stats;
+}
+
+#ifdef UNREALSDK_SHARED
+UNREALSDK_CAPI(void, dump_hook_stats, size_t count);
+#endif
+#ifndef UNREALSDK_IMPORTING
+UNREALSDK_CAPI(void, dump_hook_stats, size_t count) {
+    impl::dump_hook_stats(count);
+}
+#endif
+void dump_hook_stats(size_t count) {
+    UNREALSDK_MANGLE(dump_hook_stats)(count);
+}
+
 }  // namespace unrealsdk::hook_manager
 
 #pragma endregion
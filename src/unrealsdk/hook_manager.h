@@ -7,6 +7,7 @@
 
 namespace unrealsdk::unreal {
 
+class UClass;
 class UObject;
 class UFunction;
 
@@ -17,7 +18,8 @@ class WrappedStruct;
 namespace unrealsdk::hook_manager {
 
 /// What type of hook to add - i.e. when the callback runs
-/// Note that the order callbacks within the same type (on the same function) are run is undefined.
+/// Callbacks within the same type (on the same function) are run in order of descending priority.
+/// Callbacks with the same priority are run in the order they were added.
 enum class Type : uint8_t {
     PRE,                 /// Before running the hooked function.
     POST,                /// After the hooked function, only if it was allowed to run.
@@ -57,9 +59,55 @@ struct Details {
  */
 using Callback = std::function<bool(Details&)>;
 
+/**
+ * @brief A plain function pointer hook callback, for callers which don't need a `std::function`.
+ * @note Mainly intended for bindings from other languages, which already carry their own state.
+ * @note Must not let exceptions escape, unless it's compiled to allow them to cross dll boundaries.
+ *
+ * @param details The hook details.
+ * @param ctx The context pointer the hook was added with.
+ * @return The same as `Callback`.
+ */
+using RawCallback = bool(Details* details, void* ctx);
+
+/**
+ * @brief Frees a raw callback's context.
+ * @note Called once the hook has been removed, and is no longer running on any thread.
+ *
+ * @param ctx The context pointer the hook was added with.
+ */
+using RawCallbackContextDeleter = void(void* ctx);
+
+/// Where an unreal function call came from.
+enum class Source : uint8_t {
+    /// Any source, only valid in filters.
+    ANY,
+    /// Calls made through `UObject::ProcessEvent` - typically from native code.
+    PROCESS_EVENT,
+    /// Calls made through `UObject::CallFunction` - typically from unrealscript/blueprints.
+    CALL_FUNCTION,
+};
+
+/// Restricts a hook to only run on calls made on specific objects, or from a specific source.
+/// Filters are checked before extracting any args, so calls which don't match are almost free.
+/// If multiple fields are set, the call must match all of them.
+struct Filter {
+    /// If not null, the hook only runs on calls made on this exact object.
+    /// Only compared by address, if the object gets garbage collected, the hook may run on whatever
+    /// gets allocated in it's place.
+    const unreal::UObject* object = nullptr;
+    /// If not null, the hook only runs on calls made on objects of this class, or a subclass of it.
+    const unreal::UClass* cls = nullptr;
+    /// Which source the hook runs on calls from. Hooks restricted to one source are kept out of the
+    /// other's lookup table entirely, so calls from it never even see them.
+    Source source = Source::ANY;
+};
+
 /**
  * @brief Toggles logging all unreal function calls. Best used in short bursts for debugging.
  * @note This writes to it's own dedicated file, rather than going through the logging system.
+ * @note The file is a compact binary trace, use `tools/convert_call_trace.py` to convert it to a
+ *       tsv.
  *
  * @param should_log True to turn on logging all calls, false to turn it off.
  */
@@ -78,12 +126,41 @@ void inject_next_call(void);
  * @param type Which type of hook to add.
  * @param identifier The hook identifier.
  * @param callback The callback to run when the hooked function is called.
+ * @param priority The hook's priority. Hooks with higher priorities are run before lower ones.
+ * @param filter A filter restricting which objects the hook runs on. Runs on all by default.
  * @return True if successfully added, false if an identical hook already existed.
  */
 bool add_hook(std::wstring_view func,
               Type type,
               std::wstring_view identifier,
-              const Callback& callback);
+              const Callback& callback,
+              int32_t priority = 0,
+              const Filter& filter = {});
+
+/**
+ * @brief Adds a hook which runs a plain function pointer callback.
+ * @note Behaves identically to `add_hook`, and shares the same identifiers, it just skips the
+ *       overhead of wrapping a `std::function` - the callback is called directly.
+ *
+ * @param func The function to hook.
+ * @param type Which type of hook to add.
+ * @param identifier The hook identifier.
+ * @param callback The callback to run when the hooked function is called.
+ * @param ctx An arbitrary context pointer, passed to the callback.
+ * @param ctx_deleter If not null, called to free the context once the hook is removed. Also called
+ *                    if the hook couldn't be added.
+ * @param priority The hook's priority. Hooks with higher priorities are run before lower ones.
+ * @param filter A filter restricting which objects the hook runs on. Runs on all by default.
+ * @return True if successfully added, false if an identical hook already existed.
+ */
+bool add_raw_hook(std::wstring_view func,
+                  Type type,
+                  std::wstring_view identifier,
+                  RawCallback* callback,
+                  void* ctx,
+                  RawCallbackContextDeleter* ctx_deleter = nullptr,
+                  int32_t priority = 0,
+                  const Filter& filter = {});
 
 /**
  * @brief Checks if a hook exists.
@@ -105,6 +182,179 @@ bool has_hook(std::wstring_view func, Type type, std::wstring_view identifier);
  */
 bool remove_hook(std::wstring_view func, Type type, std::wstring_view identifier);
 
+/// A hook to add as part of a batch. See `add_hook` for what each field means.
+struct HookSpec {
+    std::wstring_view func;
+    Type type;
+    std::wstring_view identifier;
+    Callback callback;
+    int32_t priority = 0;
+    Filter filter = {};
+};
+
+/// A hook to remove as part of a batch. See `remove_hook` for what each field means.
+struct HookId {
+    std::wstring_view func;
+    Type type;
+    std::wstring_view identifier;
+};
+
+/**
+ * @brief Adds a batch of hooks at once.
+ * @note All the hooks start applying at the same time - calls never see only part of the batch.
+ * @note This is a lot faster than adding each hook individually.
+ *
+ * @param hooks The hooks to add.
+ * @return How many hooks were added. Hooks identical to one which already existed, including one
+ *         earlier in the same batch, are skipped.
+ */
+size_t add_hooks(std::span<const HookSpec> hooks);
+
+/**
+ * @brief Removes a batch of hooks at once.
+ * @note All the hooks stop applying at the same time - calls never see only part of the batch.
+ * @note This is a lot faster than removing each hook individually.
+ *
+ * @param hooks The hooks to remove.
+ * @return How many hooks were removed. Hooks which don't exist are skipped.
+ */
+size_t remove_hooks(std::span<const HookId> hooks);
+
+namespace impl {
+
+/// Bookkeeping for a coroutine waiting in `next_call`. Opaque, allocated and freed by the sdk.
+struct NextCallWaiter;
+
+}  // namespace impl
+
+/**
+ * @brief An awaitable which suspends the current coroutine until the next call to a function.
+ * @note Created using `next_call`.
+ */
+class [[nodiscard]] NextCall {
+   private:
+    std::wstring_view func;
+    impl::NextCallWaiter* waiter;
+
+   public:
+    /**
+     * @brief Constructs a new awaitable. See `next_call`.
+     *
+     * @param func The function to wait for. Must stay alive until the coroutine's been suspended.
+     * @param type When to resume, relative to the function running.
+     * @param filter A filter restricting which calls resume the coroutine.
+     */
+    NextCall(std::wstring_view func, Type type, const Filter& filter);
+
+    /**
+     * @brief Destroys the awaitable. If the coroutine's still waiting, cancels the wait.
+     * @note May be destroyed on any thread until the coroutine's been resumed - if another thread
+     *       was just about to resume it, it won't be. Destroying the coroutine while it's running
+     *       on another thread is still not allowed.
+     */
+    ~NextCall();
+
+    NextCall(const NextCall&) = delete;
+    NextCall(NextCall&&) = delete;
+    NextCall& operator=(const NextCall&) = delete;
+    NextCall& operator=(NextCall&&) = delete;
+
+    // NOLINTNEXTLINE(readability-convert-member-functions-to-static)
+    [[nodiscard]] bool await_ready(void) const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<> handle);
+    [[nodiscard]] Details& await_resume(void) const noexcept;
+};
+
+/**
+ * @brief Waits for the next call to a function, inside a coroutine.
+ * @note The coroutine is resumed inside the hook, on whichever thread made the call, exactly like
+ *       a hook callback. It receives the call's details, which are only valid until it next
+ *       suspends. It cannot block execution, use a normal hook for that.
+ * @note Waiting doesn't add/remove a hook each time. Whatever's waiting on the same function shares
+ *       a single internal hook, which is only removed once it gets called with nothing waiting on
+ *       it, so repeatedly waiting on the same function is cheap.
+ *
+ * @param func The function to wait for. Must stay alive until the coroutine's been suspended.
+ * @param type When to resume, relative to the function running.
+ * @param filter A filter restricting which calls resume the coroutine.
+ * @return An awaitable, which resumes with the call's details.
+ */
+NextCall next_call(std::wstring_view func, Type type = Type::PRE, const Filter& filter = {});
+
+/// Statistics about the hash table used to look up hooked functions
+struct HookTableStats {
+    /// The number of hooked functions.
+    size_t functions;
+    /// The number of distinct function names. Functions with the same name share a table slot.
+    size_t names;
+    /// The number of slots in the table.
+    size_t capacity;
+    /// The furthest any name ended up from it's ideal slot.
+    size_t max_probe_length;
+    /// The total distance all names ended up from their ideal slots.
+    size_t total_probe_length;
+};
+
+/**
+ * @brief Gets statistics about the hash table used to look up hooked functions.
+ *
+ * @return The table stats.
+ */
+[[nodiscard]] HookTableStats get_hook_table_stats(void);
+
+/// Timing statistics about a single hook
+struct HookStats {
+    /// The hooked function.
+    std::wstring func;
+    /// The hook type.
+    Type type;
+    /// The hook identifier.
+    std::wstring identifier;
+
+    /// The number of times the hook was run while timing was enabled.
+    uint64_t count;
+    /// The total time spent running the hook, in nanoseconds.
+    uint64_t total_ns;
+    /// The longest a single run of the hook took, in nanoseconds.
+    uint64_t max_ns;
+};
+
+/**
+ * @brief Turns timing how long each hook takes to run on or off.
+ * @note Statistics are kept when turning it off, and added to when turning it back on.
+ * @note Statistics are stored per hook, and are discarded if the hook is removed.
+ *
+ * @param enabled True to start timing hooks, false to stop.
+ */
+void set_hook_timing_enabled(bool enabled);
+
+/**
+ * @brief Checks if hooks are currently being timed.
+ *
+ * @return True if hook timing is enabled.
+ */
+[[nodiscard]] bool is_hook_timing_enabled(void);
+
+/**
+ * @brief Clears the timing statistics of all hooks.
+ */
+void reset_hook_timing(void);
+
+/**
+ * @brief Gets the timing statistics of every current hook.
+ * @note Hooks are returned in an arbitrary order.
+ *
+ * @return A list of statistics.
+ */
+[[nodiscard]] std::vector<HookStats> get_hook_stats(void);
+
+/**
+ * @brief Logs the hooks which have taken the most total time.
+ *
+ * @param count How many hooks to list.
+ */
+void dump_hook_stats(size_t count);
+
 #ifndef UNREALSDK_IMPORTING
 namespace impl {  // These functions are only relevant when implementing a game hook
 
@@ -120,8 +370,9 @@ even be able to do so for every single call (have to assume functions like that
 To deal with this, hook processing is split in three.
 
 Firstly, call `preprocess_hook`. This does some basic logging (if required), and then determines if
-the function is hooked. If it isn't, it returns `nullptr`, and calling code can early exit. If there
-is, it returns the list of hooks, to be passed to the next step.
+the function is hooked, and if any of the hooks' filters match the object it was called on. If not,
+it returns a null handle, and calling code can early exit. Otherwise, it returns a handle to the
+list of hooks, to be passed to the next step.
 
 If there is a hook, calling code can then spend more time retrieving the remaining information,
 before calling `run_hooks_of_type` using pre-hooks. This actually runs all the hooks, and returns
@@ -131,19 +382,45 @@ required.
 Extracting the return value may not be trivial either, so the calling code can run `has_post_hooks`
 to work out if to early exit again. If it does, it can spend a bit longer extracting it, then call
 `run_hooks_of_type` with the two post-hook types.
+
+Hooks may be added or removed from any thread at any time, including from inside a hook. The list
+of hooks a call sees is fixed when it's preprocessed - hooks added during a call only apply from the
+next one, while hooks removed during a call are skipped. The handle keeps the list alive, so it must
+be kept around until the call has finished running all hook types, but no longer.
 */
 
+class [[nodiscard]] NodeHandle {
+   private:
+    const Node* node;
+
+    explicit NodeHandle(const Node* node);
+
+    friend NodeHandle preprocess_hook(Source source,
+                                      const unreal::UFunction* func,
+                                      const unreal::UObject* obj);
+
+   public:
+    NodeHandle(const NodeHandle&) = delete;
+    NodeHandle(NodeHandle&& other) noexcept;
+    NodeHandle& operator=(const NodeHandle&) = delete;
+    NodeHandle& operator=(NodeHandle&&) = delete;
+    ~NodeHandle();
+
+    // NOLINTNEXTLINE(google-explicit-constructor, hicpp-explicit-conversions)
+    operator const Node*() const { return this->node; }
+};
+
 /**
  * @brief Preprocess a function call, to work out if to bother trying to run hooks on it.
  *
- * @param source The source of the call, used for logging.
+ * @param source The source of the call. May not be `Source::ANY`.
  * @param func The function which was called.
  * @param obj The object which called the function.
- * @return A node pointer to pass into the following functions, or nullptr if no hooks match.
+ * @return A handle to pass into the following functions, which is null if no hooks match.
  */
-std::shared_ptr<Node> preprocess_hook(std::wstring_view source,
-                                      const unreal::UFunction* func,
-                                      const unreal::UObject* obj);
+NodeHandle preprocess_hook(Source source,
+                           const unreal::UFunction* func,
+                           const unreal::UObject* obj);
 
 /**
  * @brief Checks if a hook list contains any post hooks.
@@ -151,17 +428,39 @@ std::shared_ptr<Node> preprocess_hook(std::wstring_view source,
  * @param node The node previously retrieved from `preprocess_hook`.
  * @return True if the list contains post hooks.
  */
-bool has_post_hooks(std::shared_ptr<Node> node);
+bool has_post_hooks(const Node* node);
 
 /**
  * @brief Runs all the hooks in a list which match the given type.
+ * @note Hooks whose filters don't match `hook.obj` are skipped.
  *
  * @param node The node previously retrieved from `preprocess_hook`.
  * @param type The type of hooks to run.
  * @param hook The hook details.
  * @return The logical or of the hooks' return values.
  */
-bool run_hooks_of_type(std::shared_ptr<Node> node, Type type, Details& hook);
+bool run_hooks_of_type(const Node* node, Type type, Details& hook);
+
+/**
+ * @brief Registers one of the detours which runs hooks, so that it can be disabled while idle.
+ * @note While there are no hooks, and nothing else needs to see every call (e.g. logging all calls,
+ *       or the profiler), these detours are disabled, so calls don't have any overhead at all.
+ * @note Never disabled while function call locking is enabled, since the detours take the lock.
+ *
+ * @param addr The address of the detoured function.
+ */
+void register_hook_detour(uintptr_t addr);
+
+/**
+ * @brief Re-checks if the hook detours are needed, and enables/disables them to match.
+ * @note Should be called whenever something other than the hooks which needs them changes.
+ */
+void update_hook_detours(void);
+
+/**
+ * @brief Registers the hook manager console commands.
+ */
+void register_commands(void);
 
 }  // namespace impl
 #endif
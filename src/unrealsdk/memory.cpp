@@ -1,6 +1,8 @@
 #include "unrealsdk/pch.h"
 
 #include "unrealsdk/memory.h"
+#include "unrealsdk/config.h"
+#include "unrealsdk/utils.h"
 
 namespace unrealsdk::memory {
 
@@ -40,33 +42,720 @@ std::pair<uintptr_t, size_t> get_exe_range(void) {
     return *range;
 }
 
-uintptr_t sigscan(const uint8_t* bytes, const uint8_t* mask, size_t pattern_size) {
-    auto [start, size] = get_exe_range();
-    return sigscan(bytes, mask, pattern_size, start, size);
+const std::vector<std::pair<uintptr_t, size_t>>& get_exe_section_ranges(SectionType type) {
+    static const auto ranges = []() {
+        std::array<std::vector<std::pair<uintptr_t, size_t>>, 3> all_ranges{};
+        auto [start, size] = get_exe_range();
+
+        std::vector<Section> sections{};
+        if (config::get_bool("unrealsdk.section_aware_sigscan").value_or(true)) {
+            sections = parse_sections({reinterpret_cast<const uint8_t*>(start), size});
+            std::ranges::sort(sections, {}, &Section::rva);
+        }
+
+        for (auto section_type : {SectionType::CODE, SectionType::DATA, SectionType::ANY}) {
+            auto& type_ranges = all_ranges.at(static_cast<size_t>(section_type));
+
+            // If we couldn't find any sections, fall back to searching the entire exe
+            if (section_type == SectionType::ANY || sections.empty()) {
+                type_ranges.emplace_back(start, size);
+                continue;
+            }
+
+            for (const auto& section : sections) {
+                if (!section.is_type(section_type) || section.rva >= size) {
+                    continue;
+                }
+                auto section_start = start + section.rva;
+                auto section_size = std::min<size_t>(section.size, size - section.rva);
+
+                // Merge with the previous range if adjacent, so patterns crossing the boundary
+                // still get found
+                if (!type_ranges.empty()
+                    && type_ranges.back().first + type_ranges.back().second >= section_start) {
+                    auto& [last_start, last_size] = type_ranges.back();
+                    last_size = std::max(last_size, section_start + section_size - last_start);
+                } else {
+                    type_ranges.emplace_back(section_start, section_size);
+                }
+            }
+        }
+
+        for (const auto& [range_start, range_size] :
+             all_ranges.at(static_cast<size_t>(SectionType::CODE))) {
+            LOG(MISC, "Code range: {:x}-{:x}", range_start, range_start + range_size);
+        }
+
+        return all_ranges;
+    }();
+
+    return ranges.at(static_cast<size_t>(type));
+}
+
+namespace {
+
+#pragma region Sigscan Settings
+
+// The max number of threads to use when picking automatically
+const constexpr size_t MAX_AUTO_SIGSCAN_THREADS = 8;
+
+/**
+ * @brief Gets the sigscan implementation to use, detecting it on first call.
+ *
+ * @return The sigscan implementation to use.
+ */
+engine::SigscanImpl get_sigscan_impl(void) {
+    static const engine::SigscanImpl sigscan_impl = [] {
+        auto detected = engine::detect_sigscan_impl();
+        LOG(MISC, "Using {} sigscan", engine::get_sigscan_impl_name(detected));
+        return detected;
+    }();
+    return sigscan_impl;
+}
+
+/**
+ * @brief Gets how many threads to split a sigscan across.
+ *
+ * @return The max number of threads to use, including the calling thread.
+ */
+size_t get_sigscan_thread_count(void) {
+    static const size_t thread_count = []() -> size_t {
+        auto configured = config::get_int<int32_t>("unrealsdk.sigscan_threads").value_or(-1);
+        if (configured > 0) {
+            return static_cast<size_t>(configured);
+        }
+        return std::clamp<size_t>(std::thread::hardware_concurrency(), 1, MAX_AUTO_SIGSCAN_THREADS);
+    }();
+    return thread_count;
+}
+
+#pragma endregion
+
+#pragma region Prescan Cache
+
+// Finding two matches is enough to tell if a pattern's unique
+const constexpr size_t UNIQUE_MAX_MATCHES = 2;
+// Stored as a second match when we stopped searching after the first
+const constexpr uintptr_t UNKNOWN_MATCH = std::numeric_limits<uintptr_t>::max();
+
+/// The first two matches of a pattern across the exe - enough to tell if it's unique.
+struct ExeMatches {
+    /// The first match, or 0 if not found.
+    uintptr_t first;
+    /// The second match, 0 if there isn't one, or `UNKNOWN_MATCH` if we didn't look for one.
+    uintptr_t second;
+};
+
+std::mutex prescan_mutex{};
+// Maps pattern contents (the bytes, mask, and section type) to where they were found in the exe
+std::unordered_map<std::string, ExeMatches> prescan_results{};
+
+/**
+ * @brief Converts the results of an exe sigscan into the matches we remember.
+ *
+ * @param matches The found matches.
+ * @param max_matches The max number of matches which were searched for.
+ * @return The matches to remember.
+ */
+ExeMatches to_exe_matches(std::span<const uintptr_t> matches, size_t max_matches) {
+    return {
+        .first = matches.empty() ? 0 : matches[0],
+        .second = matches.size() > 1 ? matches[1] : (max_matches > 1 ? 0 : UNKNOWN_MATCH),
+    };
+}
+
+/**
+ * @brief Gets the key a pattern's prescan result is stored under.
+ *
+ * @param pattern The pattern.
+ * @return The key.
+ */
+std::string get_prescan_key(const PatternView& pattern) {
+    std::string key(pattern.size * 2, '\0');
+    std::copy_n(pattern.bytes, pattern.size, key.begin());
+    std::copy_n(pattern.mask, pattern.size, key.begin() + static_cast<ptrdiff_t>(pattern.size));
+    key.push_back(static_cast<char>(pattern.section));
+    return key;
+}
+
+/**
+ * @brief Formats a pattern as a hex string, for use in log messages.
+ *
+ * @param pattern The pattern to format.
+ * @return The formatted pattern, with any masked bytes as `??`.
+ */
+std::string format_pattern(const PatternView& pattern) {
+    std::string str{};
+    for (size_t i = 0; i < pattern.size; i++) {
+        if (i != 0) {
+            str.push_back(' ');
+        }
+        str += pattern.mask[i] == std::numeric_limits<uint8_t>::max()
+                   ? std::format("{:02X}", pattern.bytes[i])
+                   : "??";
+    }
+    return str;
+}
+
+/**
+ * @brief Checks if a previously found match of a pattern is still valid.
+ * @note Our own patches (e.g. hexedits) may have overwritten the matched bytes since it was found.
+ *
+ * @param pattern The pattern which was matched.
+ * @param address The address of the match.
+ * @return True if the pattern still matches at the address.
+ */
+bool is_valid_exe_match(const PatternView& pattern, uintptr_t address) {
+    // Same bounds as a full scan would've used
+    auto in_bounds =
+        std::ranges::any_of(get_exe_section_ranges(pattern.section), [&](const auto& range) {
+            auto [start, size] = range;
+            return size > pattern.size && start <= address && address - start < size - pattern.size;
+        });
+    return in_bounds && engine::matches_at(reinterpret_cast<const uint8_t*>(address), pattern);
+}
+
+/**
+ * @brief Checks if all previously found matches of a pattern are still valid.
+ *
+ * @param pattern The pattern which was matched.
+ * @param matches The matches which were found.
+ * @return True if every found match still matches.
+ */
+bool are_valid_exe_matches(const PatternView& pattern, const ExeMatches& matches) {
+    if (matches.first != 0 && !is_valid_exe_match(pattern, matches.first)) {
+        return false;
+    }
+    return matches.second == 0 || matches.second == UNKNOWN_MATCH
+           || is_valid_exe_match(pattern, matches.second);
+}
+
+#pragma endregion
+
+#pragma region Sigscan Cache
+
+/*
+Since the exe is almost always the same between launches, we keep a cache file of where we found
+each pattern last time. This is keyed on the exe's identity, so updating the game throws away the
+whole cache. Individual entries are still checked against memory before being trusted, and fall back
+to a full scan if they don't match.
+
+Only patterns which were found are cached - a miss can't be verified without scanning anyway. We
+also store the second match, if we searched for one, so that uniqueness checks can be cached too.
+
+All values are little endian. The file consists of:
+    char[8]  magic            "USDKSCAN"
+    u32      version          3
+    u32      timestamp        The exe's PE header timestamp.
+    u32      size_of_image    The exe's size in memory.
+    u64      header_hash      An FNV-1a hash of the exe's PE headers.
+    u32      count
+    Followed by `count` entries:
+    u64      pattern_hash     An FNV-1a hash of the pattern's bytes, mask, and section type.
+    u64      rva              Where the pattern was found, relative to the start of the exe.
+    u64      second_rva       Where the pattern's second match was, 0 if it has none, or all bits
+                              set if we didn't search for one.
+*/
+
+const constexpr std::array<char, 8> CACHE_FILE_MAGIC = {'U', 'S', 'D', 'K', 'S', 'C', 'A', 'N'};
+const constexpr uint32_t CACHE_FILE_VERSION = 3;
+const constexpr uint64_t CACHE_UNKNOWN_RVA = std::numeric_limits<uint64_t>::max();
+
+const constexpr uint64_t FNV_OFFSET_BASIS = 0xCBF29CE484222325;
+const constexpr uint64_t FNV_PRIME = 0x100000001B3;
+
+struct ExeIdentity {
+    uint32_t timestamp;
+    uint32_t size_of_image;
+    uint64_t header_hash;
+
+    bool operator==(const ExeIdentity&) const = default;
+};
+
+struct SigscanCacheEntry {
+    uint64_t rva;
+    uint64_t second_rva;
+
+    bool operator==(const SigscanCacheEntry&) const = default;
+};
+
+struct SigscanCache {
+    std::filesystem::path path;
+    ExeIdentity identity;
+    // Maps pattern hashes to where they were found
+    std::unordered_map<uint64_t, SigscanCacheEntry> entries;
+};
+
+std::mutex sigscan_cache_mutex{};
+
+/**
+ * @brief Adds some data to an FNV-1a hash.
+ *
+ * @param data The data to hash.
+ * @param size The length of the data.
+ * @param hash The hash so far.
+ * @return The new hash.
+ */
+uint64_t fnv1a(const uint8_t* data, size_t size, uint64_t hash = FNV_OFFSET_BASIS) {
+    for (size_t i = 0; i < size; i++) {
+        hash = (hash ^ data[i]) * FNV_PRIME;
+    }
+    return hash;
+}
+
+/**
+ * @brief Gets the hash a pattern is stored under in the sigscan cache.
+ *
+ * @param pattern The pattern.
+ * @return The hash.
+ */
+uint64_t get_pattern_hash(const PatternView& pattern) {
+    auto hash = fnv1a(pattern.mask, pattern.size, fnv1a(pattern.bytes, pattern.size));
+    auto section = static_cast<uint8_t>(pattern.section);
+    return fnv1a(&section, sizeof(section), hash);
+}
+
+/**
+ * @brief Writes the sigscan cache out to disk.
+ * @note Assumes the sigscan cache mutex is held.
+ *
+ * @param cache The cache to write.
+ */
+void save_sigscan_cache(const SigscanCache& cache) {
+    std::ofstream stream{cache.path, std::ofstream::binary | std::ofstream::trunc};
+
+    auto write_value = [&stream](const auto& value) {
+        static_assert(std::is_trivially_copyable_v<std::remove_cvref_t<decltype(value)>>);
+        stream.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    };
+
+    write_value(CACHE_FILE_MAGIC);
+    write_value(CACHE_FILE_VERSION);
+    write_value(cache.identity.timestamp);
+    write_value(cache.identity.size_of_image);
+    write_value(cache.identity.header_hash);
+    write_value(static_cast<uint32_t>(cache.entries.size()));
+    for (const auto& [pattern_hash, entry] : cache.entries) {
+        write_value(pattern_hash);
+        write_value(entry.rva);
+        write_value(entry.second_rva);
+    }
+
+    if (!stream.good()) {
+        LOG(WARNING, "Failed to write sigscan cache: {}", cache.path.string());
+    }
+}
+
+#ifndef UNREALSDK_IMPORTING
+
+/**
+ * @brief Gets the identity of the exe, used to check if the sigscan cache is still valid.
+ *
+ * @return The exe's identity.
+ */
+ExeIdentity get_exe_identity(void) {
+    auto start = get_exe_range().first;
+
+    auto dos_header = reinterpret_cast<IMAGE_DOS_HEADER*>(start);
+    auto nt_header = reinterpret_cast<IMAGE_NT_HEADERS*>(start + dos_header->e_lfanew);
+
+    return {
+        .timestamp = static_cast<uint32_t>(nt_header->FileHeader.TimeDateStamp),
+        .size_of_image = static_cast<uint32_t>(nt_header->OptionalHeader.SizeOfImage),
+        .header_hash = fnv1a(reinterpret_cast<const uint8_t*>(start),
+                             nt_header->OptionalHeader.SizeOfHeaders),
+    };
+}
+
+/**
+ * @brief Loads the sigscan cache from disk.
+ *
+ * @return The loaded cache, or std::nullopt if it's disabled.
+ */
+std::optional<SigscanCache> load_sigscan_cache(void) {
+    auto filename =
+        config::get_str("unrealsdk.sigscan_cache_file").value_or("unrealsdk.sigscans.bin");
+    if (filename.empty()) {
+        return std::nullopt;
+    }
+
+    SigscanCache cache{.path = utils::get_this_dll().parent_path() / filename,
+                       .identity = get_exe_identity(),
+                       .entries = {}};
+
+    std::ifstream stream{cache.path, std::ifstream::binary};
+    if (!stream.is_open()) {
+        return cache;
+    }
+
+    auto read_value = [&stream](auto& value) {
+        stream.read(reinterpret_cast<char*>(&value), sizeof(value));
+        return stream.good();
+    };
+
+    std::array<char, CACHE_FILE_MAGIC.size()> magic{};
+    uint32_t version{};
+    ExeIdentity identity{};
+    uint32_t count{};
+    if (!read_value(magic) || !read_value(version) || !read_value(identity.timestamp)
+        || !read_value(identity.size_of_image) || !read_value(identity.header_hash)
+        || !read_value(count) || magic != CACHE_FILE_MAGIC || version != CACHE_FILE_VERSION) {
+        LOG(MISC, "Ignoring invalid sigscan cache");
+        return cache;
+    }
+    if (identity != cache.identity) {
+        LOG(MISC, "Ignoring sigscan cache from a different executable");
+        return cache;
+    }
+
+    for (uint32_t i = 0; i < count; i++) {
+        uint64_t pattern_hash{};
+        SigscanCacheEntry entry{};
+        if (!read_value(pattern_hash) || !read_value(entry.rva) || !read_value(entry.second_rva)) {
+            LOG(MISC, "Ignoring truncated sigscan cache");
+            cache.entries.clear();
+            return cache;
+        }
+        cache.entries[pattern_hash] = entry;
+    }
+
+    LOG(MISC, "Loaded {} entries from the sigscan cache", cache.entries.size());
+    return cache;
+}
+
+#endif
+
+/**
+ * @brief Gets the sigscan cache, loading it on first call.
+ * @note Assumes the sigscan cache mutex is held.
+ *
+ * @return A pointer to the cache, or nullptr if it's disabled.
+ */
+SigscanCache* get_sigscan_cache(void) {
+#ifdef UNREALSDK_IMPORTING
+    // Only the sdk itself uses the cache, so that modules linking against it don't fight over the
+    // file
+    return nullptr;
+#else
+    static std::optional<SigscanCache> cache = load_sigscan_cache();
+    return cache.has_value() ? &*cache : nullptr;
+#endif
+}
+
+/**
+ * @brief Looks up a pattern in the sigscan cache, and checks it's still valid.
+ *
+ * @param pattern The pattern to look up.
+ * @return The cached matches, or std::nullopt if not cached or they no longer match.
+ */
+std::optional<ExeMatches> find_cached_sigscan(const PatternView& pattern) {
+    const std::scoped_lock lock(sigscan_cache_mutex);
+    auto cache = get_sigscan_cache();
+    if (cache == nullptr) {
+        return std::nullopt;
+    }
+
+    auto iter = cache->entries.find(get_pattern_hash(pattern));
+    if (iter == cache->entries.end()) {
+        return std::nullopt;
+    }
+
+    auto exe_start = get_exe_range().first;
+    ExeMatches matches{.first = exe_start + static_cast<uintptr_t>(iter->second.rva),
+                       .second = UNKNOWN_MATCH};
+    if (iter->second.second_rva == 0) {
+        matches.second = 0;
+    } else if (iter->second.second_rva != CACHE_UNKNOWN_RVA) {
+        matches.second = exe_start + static_cast<uintptr_t>(iter->second.second_rva);
+    }
+
+    if (!are_valid_exe_matches(pattern, matches)) {
+        return std::nullopt;
+    }
+    return matches;
+}
+
+/**
+ * @brief Adds the results of some exe sigscans to the cache, and writes it out if anything changed.
+ *
+ * @param patterns The patterns which were scanned for.
+ * @param results The matches found for each pattern.
+ */
+void update_sigscan_cache(std::span<const PatternView> patterns,
+                          std::span<const ExeMatches> results) {
+    const std::scoped_lock lock(sigscan_cache_mutex);
+    auto cache = get_sigscan_cache();
+    if (cache == nullptr) {
+        return;
+    }
+
+    auto start = get_exe_range().first;
+
+    bool changed = false;
+    for (size_t i = 0; i < patterns.size(); i++) {
+        const auto& matches = results[i];
+        if (matches.first == 0) {
+            continue;
+        }
+
+        SigscanCacheEntry entry{.rva = static_cast<uint64_t>(matches.first - start),
+                                .second_rva = CACHE_UNKNOWN_RVA};
+        if (matches.second != UNKNOWN_MATCH) {
+            entry.second_rva =
+                matches.second == 0 ? 0 : static_cast<uint64_t>(matches.second - start);
+        }
+
+        auto [iter, inserted] = cache->entries.try_emplace(get_pattern_hash(patterns[i]), entry);
+        if (inserted) {
+            changed = true;
+            continue;
+        }
+
+        // Don't forget about a second match just because this scan didn't look for one
+        if (entry.second_rva == CACHE_UNKNOWN_RVA && entry.rva == iter->second.rva) {
+            entry.second_rva = iter->second.second_rva;
+        }
+        if (iter->second != entry) {
+            iter->second = entry;
+            changed = true;
+        }
+    }
+
+    if (changed) {
+        save_sigscan_cache(*cache);
+    }
+}
+
+#pragma endregion
+
+#pragma region Exe Sigscan
+
+/**
+ * @brief Looks up the matches we already know about for a pattern, from the prescan or the cache.
+ *
+ * @param pattern The pattern to look up.
+ * @return The known matches, or std::nullopt if we need to scan for them.
+ */
+std::optional<ExeMatches> find_known_matches(const PatternView& pattern) {
+    std::optional<ExeMatches> prescanned{};
+    {
+        const std::scoped_lock lock(prescan_mutex);
+        if (!prescan_results.empty()) {
+            auto iter = prescan_results.find(get_prescan_key(pattern));
+            if (iter != prescan_results.end()) {
+                prescanned = iter->second;
+            }
+        }
+    }
+
+    // Just like cache entries, prescan results may have been patched over since, in which case fall
+    // back to scanning for them again, so we match what a fresh scan would return
+    if (prescanned.has_value() && are_valid_exe_matches(pattern, *prescanned)) {
+        return prescanned;
+    }
+
+    return find_cached_sigscan(pattern);
+}
+
+/**
+ * @brief Scans the exe for several patterns at once, each within it's own section type.
+ *
+ * @param patterns The patterns to search for.
+ * @param max_matches The max number of matches to find of each pattern.
+ * @return The found locations of each pattern, in increasing order, in the same order as given.
+ */
+std::vector<std::vector<uintptr_t>> sigscan_exe(std::span<const PatternView> patterns,
+                                                size_t max_matches) {
+    std::vector<std::vector<uintptr_t>> results(patterns.size());
+
+    for (auto section : {SectionType::CODE, SectionType::DATA, SectionType::ANY}) {
+        std::vector<PatternView> remaining{};
+        std::vector<size_t> remaining_indexes{};
+        for (size_t i = 0; i < patterns.size(); i++) {
+            if (patterns[i].section == section) {
+                remaining.push_back(patterns[i]);
+                remaining_indexes.push_back(i);
+            }
+        }
+
+        // Ranges are in increasing order, so we can just append each range's matches
+        for (const auto& [start, size] : get_exe_section_ranges(section)) {
+            if (remaining.empty()) {
+                break;
+            }
+
+            auto range_results =
+                engine::sigscan_many_all(remaining, start, size, get_sigscan_impl(),
+                                         get_sigscan_thread_count(), max_matches);
+
+            size_t still_remaining = 0;
+            for (size_t i = 0; i < remaining.size(); i++) {
+                auto& matches = results[remaining_indexes[i]];
+                auto to_add = std::min(range_results[i].size(), max_matches - matches.size());
+                matches.insert(matches.end(), range_results[i].begin(),
+                               range_results[i].begin() + static_cast<ptrdiff_t>(to_add));
+
+                if (matches.size() < max_matches) {
+                    remaining[still_remaining] = remaining[i];
+                    remaining_indexes[still_remaining] = remaining_indexes[i];
+                    still_remaining++;
+                }
+            }
+            remaining.resize(still_remaining);
+            remaining_indexes.resize(still_remaining);
+        }
+    }
+
+    return results;
+}
+
+#pragma endregion
+
+}  // namespace
+
+uintptr_t sigscan(const uint8_t* bytes,
+                  const uint8_t* mask,
+                  size_t pattern_size,
+                  SectionType section) {
+    auto matches = sigscan_all(bytes, mask, pattern_size, section, 1);
+    return matches.empty() ? 0 : matches.front();
 }
 uintptr_t sigscan(const uint8_t* bytes,
                   const uint8_t* mask,
                   size_t pattern_size,
                   uintptr_t start,
                   size_t size) {
-    auto start_ptr = reinterpret_cast<uint8_t*>(start);
-
-    // The naive O(nm) search works well enough, even repeating it for each different pattern
-    for (size_t i = 0; i < (size - pattern_size); i++) {
-        bool found = true;
-        for (size_t j = 0; j < pattern_size; j++) {
-            auto val = start_ptr[i + j];
-            if ((val & mask[j]) != bytes[j]) {
-                found = false;
-                break;
+    return engine::sigscan({.bytes = bytes, .mask = mask, .size = pattern_size}, start, size,
+                           get_sigscan_impl(), get_sigscan_thread_count());
+}
+
+std::vector<uintptr_t> sigscan_all(const uint8_t* bytes,
+                                   const uint8_t* mask,
+                                   size_t pattern_size,
+                                   SectionType section,
+                                   size_t max_matches) {
+    if (max_matches == 0) {
+        return {};
+    }
+
+    const PatternView pattern{
+        .bytes = bytes, .mask = mask, .size = pattern_size, .section = section};
+
+    // We only ever remember the first two matches
+    auto known = find_known_matches(pattern);
+    if (known.has_value()
+        && (max_matches == 1
+            || (max_matches == UNIQUE_MAX_MATCHES && known->second != UNKNOWN_MATCH))) {
+        std::vector<uintptr_t> matches{};
+        if (known->first != 0) {
+            matches.push_back(known->first);
+            if (max_matches > 1 && known->second != 0) {
+                matches.push_back(known->second);
             }
         }
-        if (found) {
-            return reinterpret_cast<uintptr_t>(&start_ptr[i]);
+        return matches;
+    }
+
+    auto matches = std::move(sigscan_exe({&pattern, 1}, max_matches).front());
+
+    auto found = to_exe_matches(matches, max_matches);
+    update_sigscan_cache({&pattern, 1}, {&found, 1});
+
+    return matches;
+}
+std::vector<uintptr_t> sigscan_all(const uint8_t* bytes,
+                                   const uint8_t* mask,
+                                   size_t pattern_size,
+                                   uintptr_t start,
+                                   size_t size,
+                                   size_t max_matches) {
+    return engine::sigscan_all({.bytes = bytes, .mask = mask, .size = pattern_size}, start, size,
+                               get_sigscan_impl(), get_sigscan_thread_count(), max_matches);
+}
+
+uintptr_t sigscan_unique(const uint8_t* bytes,
+                         const uint8_t* mask,
+                         size_t pattern_size,
+                         SectionType section) {
+    auto matches = sigscan_all(bytes, mask, pattern_size, section, UNIQUE_MAX_MATCHES);
+    return matches.size() == 1 ? matches.front() : 0;
+}
+uintptr_t sigscan_unique(const uint8_t* bytes,
+                         const uint8_t* mask,
+                         size_t pattern_size,
+                         uintptr_t start,
+                         size_t size) {
+    auto matches = sigscan_all(bytes, mask, pattern_size, start, size, UNIQUE_MAX_MATCHES);
+    return matches.size() == 1 ? matches.front() : 0;
+}
+
+std::vector<uintptr_t> sigscan_many(std::span<const PatternView> patterns) {
+    auto matches = sigscan_exe(patterns, 1);
+
+    std::vector<uintptr_t> results(patterns.size());
+    for (size_t i = 0; i < patterns.size(); i++) {
+        if (!matches[i].empty()) {
+            results[i] = matches[i].front();
+        }
+    }
+    return results;
+}
+std::vector<uintptr_t> sigscan_many(std::span<const PatternView> patterns,
+                                    uintptr_t start,
+                                    size_t size) {
+    return engine::sigscan_many(patterns, start, size, get_sigscan_impl(),
+                                get_sigscan_thread_count());
+}
+
+void prescan(std::span<const PatternView> patterns) {
+    std::vector<ExeMatches> results(patterns.size());
+
+    // Only scan for what we couldn't get from the sigscan cache
+    std::vector<PatternView> uncached{};
+    std::vector<size_t> uncached_indexes{};
+    for (size_t i = 0; i < patterns.size(); i++) {
+        auto cached = find_cached_sigscan(patterns[i]);
+        if (cached.has_value() && cached->second != UNKNOWN_MATCH) {
+            results[i] = *cached;
+        } else {
+            uncached.push_back(patterns[i]);
+            uncached_indexes.push_back(i);
         }
     }
 
-    return 0;
+    LOG(MISC, "Found {}/{} prescan patterns in the sigscan cache",
+        patterns.size() - uncached.size(), patterns.size());
+
+    if (!uncached.empty()) {
+        // Look for a second match of each pattern in the same pass, so that uniqueness checks on
+        // them are free
+        auto uncached_matches = sigscan_exe(uncached, UNIQUE_MAX_MATCHES);
+
+        std::vector<ExeMatches> uncached_results{};
+        for (const auto& matches : uncached_matches) {
+            uncached_results.push_back(to_exe_matches(matches, UNIQUE_MAX_MATCHES));
+        }
+        update_sigscan_cache(uncached, uncached_results);
+
+        for (size_t i = 0; i < uncached.size(); i++) {
+            results[uncached_indexes[i]] = uncached_results[i];
+        }
+    }
+
+    // Anything matching more than once is probably a sign it's picking up the wrong thing
+    for (size_t i = 0; i < patterns.size(); i++) {
+        const auto& matches = results[i];
+        if (matches.second != 0 && matches.second != UNKNOWN_MATCH) {
+            LOG(WARNING, "Prescan pattern matched multiple times, at {:x} and {:x}: {}",
+                matches.first, matches.second, format_pattern(patterns[i]));
+        }
+    }
+
+    const std::scoped_lock lock(prescan_mutex);
+    for (size_t i = 0; i < patterns.size(); i++) {
+        const auto& pattern = patterns[i];
+        prescan_results.insert_or_assign(get_prescan_key(pattern), results[i]);
+    }
 }
 
 #ifdef UNREALSDK_SHARED
@@ -142,4 +831,4 @@ void unlock_range(uintptr_t start, size_t size) {
     }
 }
 
-}  // namespace unrealsdk::memory
+}  // namespace unrealsdk::memory
\ No newline at end of file
@@ -3,11 +3,23 @@
 
 #include "unrealsdk/pch.h"
 
+#include "unrealsdk/sigscan.h"
+
 namespace unrealsdk::memory {
 
 template <size_t n>
 struct Pattern;
 
+/**
+ * @brief Gets the address ranges covered by the exe's sections of the given type.
+ * @note Adjacent sections are merged into a single range.
+ *
+ * @param type The section type to get.
+ * @return A list of pairs of the range start address and it's length, in increasing order.
+ */
+[[nodiscard]] const std::vector<std::pair<uintptr_t, size_t>>& get_exe_section_ranges(
+    SectionType type);
+
 /**
  * @brief Performs a sigscan.
  *
@@ -15,19 +27,26 @@ struct Pattern;
  * @param bytes The bytes to search for.
  * @param mask The mask over the bytes to search for.
  * @param pattern_size The size of the bytes + mask.
+ * @param section The type of exe section to search through, when searching across the exe.
  * @param start The address to start the search at. Defaults to the start of the exe.
  * @param size The length of the region to search. Defaults to the exe size
  * @return The found location, or nullptr.
  */
-uintptr_t sigscan(const uint8_t* bytes, const uint8_t* mask, size_t pattern_size);
+uintptr_t sigscan(const uint8_t* bytes,
+                  const uint8_t* mask,
+                  size_t pattern_size,
+                  SectionType section = SectionType::CODE);
 uintptr_t sigscan(const uint8_t* bytes,
                   const uint8_t* mask,
                   size_t pattern_size,
                   uintptr_t start,
                   size_t size);
 template <typename T>
-T sigscan(const uint8_t* bytes, const uint8_t* mask, size_t pattern_size) {
-    return reinterpret_cast<T>(sigscan(bytes, mask, pattern_size));
+T sigscan(const uint8_t* bytes,
+          const uint8_t* mask,
+          size_t pattern_size,
+          SectionType section = SectionType::CODE) {
+    return reinterpret_cast<T>(sigscan(bytes, mask, pattern_size, section));
 }
 template <typename T>
 T sigscan(const uint8_t* bytes,
@@ -38,6 +57,96 @@ T sigscan(const uint8_t* bytes,
     return reinterpret_cast<T>(sigscan(bytes, mask, pattern_size, start, size));
 }
 
+/**
+ * @brief Performs a sigscan for every match of a pattern.
+ * @note This is still a single pass over memory, the scan just continues past each match.
+ *
+ * @param bytes The bytes to search for.
+ * @param mask The mask over the bytes to search for.
+ * @param pattern_size The size of the bytes + mask.
+ * @param section The type of exe section to search through, when searching across the exe.
+ * @param start The address to start the search at. Defaults to the start of the exe.
+ * @param size The length of the region to search. Defaults to the exe size
+ * @param max_matches The max number of matches to find, after which the scan stops early.
+ * @return The found locations, in increasing order.
+ */
+[[nodiscard]] std::vector<uintptr_t> sigscan_all(const uint8_t* bytes,
+                                                 const uint8_t* mask,
+                                                 size_t pattern_size,
+                                                 SectionType section = SectionType::CODE,
+                                                 size_t max_matches = ALL_MATCHES);
+[[nodiscard]] std::vector<uintptr_t> sigscan_all(const uint8_t* bytes,
+                                                 const uint8_t* mask,
+                                                 size_t pattern_size,
+                                                 uintptr_t start,
+                                                 size_t size,
+                                                 size_t max_matches = ALL_MATCHES);
+
+/**
+ * @brief Performs a sigscan, making sure the pattern only matches once.
+ * @note Checked within the same pass - the scan just continues past the first match, until it finds
+ *       a second one or reaches the end. Patterns which were prescanned were already checked.
+ *
+ * @tparam T The type to cast the result to.
+ * @param bytes The bytes to search for.
+ * @param mask The mask over the bytes to search for.
+ * @param pattern_size The size of the bytes + mask.
+ * @param section The type of exe section to search through, when searching across the exe.
+ * @param start The address to start the search at. Defaults to the start of the exe.
+ * @param size The length of the region to search. Defaults to the exe size
+ * @return The found location, or nullptr if not found or if it matched more than once.
+ */
+uintptr_t sigscan_unique(const uint8_t* bytes,
+                         const uint8_t* mask,
+                         size_t pattern_size,
+                         SectionType section = SectionType::CODE);
+uintptr_t sigscan_unique(const uint8_t* bytes,
+                         const uint8_t* mask,
+                         size_t pattern_size,
+                         uintptr_t start,
+                         size_t size);
+template <typename T>
+T sigscan_unique(const uint8_t* bytes,
+                 const uint8_t* mask,
+                 size_t pattern_size,
+                 SectionType section = SectionType::CODE) {
+    return reinterpret_cast<T>(sigscan_unique(bytes, mask, pattern_size, section));
+}
+template <typename T>
+T sigscan_unique(const uint8_t* bytes,
+                 const uint8_t* mask,
+                 size_t pattern_size,
+                 uintptr_t start,
+                 size_t size) {
+    return reinterpret_cast<T>(sigscan_unique(bytes, mask, pattern_size, start, size));
+}
+
+/**
+ * @brief Performs a sigscan for several patterns at once, in a single pass over memory.
+ * @note Each pattern gets the same result it would from calling `sigscan` on it individually.
+ *
+ * @param patterns The patterns to search for. When searching across the exe, each pattern only
+ *                 searches through it's own section type.
+ * @param start The address to start the search at. Defaults to the start of the exe.
+ * @param size The length of the region to search. Defaults to the exe size
+ * @return The found location of each pattern (or nullptr), in the same order as given.
+ */
+std::vector<uintptr_t> sigscan_many(std::span<const PatternView> patterns);
+std::vector<uintptr_t> sigscan_many(std::span<const PatternView> patterns,
+                                    uintptr_t start,
+                                    size_t size);
+
+/**
+ * @brief Scans the exe for several patterns at once, and remembers the results.
+ * @note Later sigscans across the exe for any of the same patterns return the remembered result
+ *       immediately, rather than scanning again. Patterns are matched by value, not by address.
+ * @note This also looks for a second match of each pattern, so `sigscan_unique` is free too. Any
+ *       pattern which matches more than once is logged as a warning.
+ *
+ * @param patterns The patterns to search for.
+ */
+void prescan(std::span<const PatternView> patterns);
+
 /**
  * @brief Detours a function.
  *
@@ -107,6 +216,19 @@ struct Pattern {
     std::array<uint8_t, n> mask;
     /// A constant offset to add to the found address.
     ptrdiff_t offset = 0;
+    /// The type of exe section to search through. This is where the matched bytes live, not what
+    /// they point at - a pattern which finds a global by reading it out of an instruction is CODE.
+    SectionType section = SectionType::CODE;
+
+    /**
+     * @brief Gets a view over this pattern's bytes and mask.
+     * @note Does not include the offset.
+     *
+     * @return The pattern view.
+     */
+    [[nodiscard]] constexpr PatternView view(void) const {
+        return {this->bytes.data(), this->mask.data(), n, this->section};
+    }
 
     /**
      * @brief Construct a pattern.
@@ -114,14 +236,22 @@ struct Pattern {
      * @param bytes The bytes to match.
      * @param mask The mask over the bytes to match.
      * @param offset The constant offset to add to the found address.
+     * @param section The type of exe section to search through.
      * @return A sigscan pattern.
      */
-    Pattern(const uint8_t (&bytes)[n], const uint8_t (&mask)[n], ptrdiff_t offset = 0)
-        : bytes(bytes), mask(mask), offset(offset) {}
-    Pattern(const char (&bytes)[n + 1], const char (&mask)[n + 1], ptrdiff_t offset = 0)
+    Pattern(const uint8_t (&bytes)[n],
+            const uint8_t (&mask)[n],
+            ptrdiff_t offset = 0,
+            SectionType section = SectionType::CODE)
+        : bytes(bytes), mask(mask), offset(offset), section(section) {}
+    Pattern(const char (&bytes)[n + 1],
+            const char (&mask)[n + 1],
+            ptrdiff_t offset = 0,
+            SectionType section = SectionType::CODE)
         : bytes(reinterpret_cast<const uint8_t*>(bytes)),
           mask(reinterpret_cast<const uint8_t*>(mask)),
-          offset(offset) {
+          offset(offset),
+          section(section) {
         static_assert(sizeof(uint8_t) == sizeof(char), "uint8_t is different size to char");
     }
 
@@ -157,13 +287,18 @@ struct Pattern {
      *
      * @tparam m The size of the passed hex string - should be picked up automatically.
      * @param hex The hex string to convert.
+     * @param section The type of exe section to search through.
      * @param offset The constant offset to add to the found address.
      * @return A sigscan pattern.
      */
     template <size_t m>
+    consteval Pattern(const char (&hex)[m], SectionType section)
+        : Pattern(hex, std::numeric_limits<ptrdiff_t>::max(), section) {}
+    template <size_t m>
     consteval Pattern(const char (&hex)[m],
-                      ptrdiff_t offset = std::numeric_limits<ptrdiff_t>::max())
-        : bytes(), mask(), offset(offset) {
+                      ptrdiff_t offset = std::numeric_limits<ptrdiff_t>::max(),
+                      SectionType section = SectionType::CODE)
+        : bytes(), mask(), offset(offset), section(section) {
         ptrdiff_t idx = 0;
         bool upper_nibble = true;
 
@@ -219,7 +354,7 @@ struct Pattern {
      * @return The found location, or 0.
      */
     [[nodiscard]] uintptr_t sigscan(std::string_view name) const {
-        auto addr = memory::sigscan(this->bytes.data(), this->mask.data(), n);
+        auto addr = memory::sigscan(this->bytes.data(), this->mask.data(), n, this->section);
         if (addr == 0) {
             // Make sure to log something on error, even if calling code doesn't catch it
             LOG(ERROR, "Sigscan for {} failed!", name);
@@ -232,13 +367,120 @@ struct Pattern {
         return reinterpret_cast<T>(this->sigscan(name));
     }
     [[nodiscard]] uintptr_t sigscan_nullable(void) const {
-        auto addr = memory::sigscan(this->bytes.data(), this->mask.data(), n);
+        auto addr = memory::sigscan(this->bytes.data(), this->mask.data(), n, this->section);
         return addr == 0 ? 0 : addr + offset;
     }
     template <typename T>
     [[nodiscard]] T sigscan_nullable(void) const {
         return reinterpret_cast<T>(this->sigscan_nullable());
     }
+
+    /**
+     * @brief Performs a sigscan for this pattern across the main executable, making sure it only
+     *        matches once.
+     * @note Throws if the pattern isn't found, or if it's found more than once.
+     *
+     * @tparam T The type to cast the result to.
+     * @param name The name of this pattern, to use in error messages.
+     * @return The found location.
+     */
+    [[nodiscard]] uintptr_t sigscan_unique(std::string_view name) const {
+        // Two matches is enough to tell it's not unique
+        auto matches =
+            memory::sigscan_all(this->bytes.data(), this->mask.data(), n, this->section, 2);
+        if (matches.empty()) {
+            LOG(ERROR, "Sigscan for {} failed!", name);
+            throw std::runtime_error("sigscan failed");
+        }
+        if (matches.size() > 1) {
+            LOG(ERROR, "Sigscan for {} found multiple matches, at {:x} and {:x}!", name,
+                matches[0], matches[1]);
+            throw std::runtime_error("sigscan found multiple matches");
+        }
+        return matches.front() + offset;
+    }
+    template <typename T>
+    [[nodiscard]] T sigscan_unique(std::string_view name) const {
+        return reinterpret_cast<T>(this->sigscan_unique(name));
+    }
+
+    /**
+     * @brief Performs a sigscan for this pattern across the main executable, making sure it only
+     *        matches once, without throwing.
+     * @note Logs an error if the pattern's found more than once.
+     *
+     * @tparam T The type to cast the result to.
+     * @param name The name of this pattern, to use in error messages.
+     * @return The found location, or 0 if not found or not unique.
+     */
+    [[nodiscard]] uintptr_t sigscan_unique_nullable(std::string_view name) const {
+        auto matches =
+            memory::sigscan_all(this->bytes.data(), this->mask.data(), n, this->section, 2);
+        if (matches.size() > 1) {
+            LOG(ERROR, "Sigscan for {} found multiple matches, at {:x} and {:x}!", name,
+                matches[0], matches[1]);
+            return 0;
+        }
+        return matches.empty() ? 0 : matches.front() + offset;
+    }
+    template <typename T>
+    [[nodiscard]] T sigscan_unique_nullable(std::string_view name) const {
+        return reinterpret_cast<T>(this->sigscan_unique_nullable(name));
+    }
+
+    /**
+     * @brief Performs a sigscan for every match of this pattern across the main executable.
+     *
+     * @param max_matches The max number of matches to find, after which the scan stops early.
+     * @return The found locations, in increasing order.
+     */
+    [[nodiscard]] std::vector<uintptr_t> sigscan_all(size_t max_matches = ALL_MATCHES) const {
+        auto matches = memory::sigscan_all(this->bytes.data(), this->mask.data(), n,
+                                           this->section, max_matches);
+        for (auto& addr : matches) {
+            addr += offset;
+        }
+        return matches;
+    }
+};
+
+/**
+ * @brief Registers patterns to be prescanned as part of a group.
+ * @note Intended to be declared as a static alongside each pattern, so that a game hook can scan
+ *       for all of them in a single pass, before it starts looking for any of them individually.
+ *
+ * @tparam Group A type used to tell groups apart - typically the game hook class.
+ */
+template <typename Group>
+class PrescanEntry {
+   private:
+    /**
+     * @brief Gets the patterns registered to this group.
+     *
+     * @return A reference to the list of patterns.
+     */
+    static std::vector<PatternView>& patterns(void) {
+        // Function static, so that it's initialized before any entry gets registered into it
+        static std::vector<PatternView> patterns{};
+        return patterns;
+    }
+
+   public:
+    /**
+     * @brief Registers patterns to this group.
+     *
+     * @tparam ns The sizes of the patterns (should be picked up automatically).
+     * @param patterns The patterns to register. Must outlive the prescan.
+     */
+    template <size_t... ns>
+    explicit PrescanEntry(const Pattern<ns>&... patterns) {
+        (PrescanEntry::patterns().push_back(patterns.view()), ...);
+    }
+
+    /**
+     * @brief Prescans for all patterns registered to this group.
+     */
+    static void prescan_all(void) { memory::prescan(PrescanEntry::patterns()); }
 };
 
 /**
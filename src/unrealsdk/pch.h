@@ -33,10 +33,12 @@
 #include <algorithm>
 #include <array>
 #include <atomic>
+#include <bit>
 #include <cctype>
 #include <charconv>
 #include <chrono>
 #include <condition_variable>
+#include <coroutine>
 #include <cstdint>
 #include <cstring>
 #include <cwctype>
@@ -52,6 +54,8 @@
 #include <optional>
 #include <queue>
 #include <ranges>
+#include <shared_mutex>
+#include <span>
 #include <sstream>
 #include <stdexcept>
 #include <string>
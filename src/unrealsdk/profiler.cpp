@@ -0,0 +1,524 @@
+#include "unrealsdk/pch.h"
+#include "unrealsdk/commands.h"
+#include "unrealsdk/hook_manager.h"
+#include "unrealsdk/profiler.h"
+#include "unrealsdk/unreal/classes/ufunction.h"
+#include "unrealsdk/utils.h"
+
+using namespace unrealsdk::unreal;
+
+namespace unrealsdk::profiler {
+
+#pragma region Implementation
+#ifndef UNREALSDK_IMPORTING
+
+namespace {
+
+/*
+Stats are stored in a fixed size, open addressed, hash table, keyed by function pointer. Slots are
+claimed with a CAS on the key, and then never released, so lookups never need to take a lock. All
+counters are relaxed atomics, we don't care about them being consistent with each other, only about
+them being cheap to increment from whichever thread a call comes from.
+
+The table is only allocated the first time profiling is enabled, and is never freed after that,
+since there may always be a call in flight which is still using it.
+*/
+
+const constexpr size_t TABLE_SIZE = 0x4000;
+const constexpr size_t MAX_PROBES = 64;
+
+struct FunctionSlot {
+    std::atomic<const UFunction*> func = nullptr;
+    // Set after the name is written, the name is never modified after this
+    std::atomic<bool> ready = false;
+    // Left empty if we couldn't get the function's name
+    std::wstring name;
+
+    std::atomic<uint64_t> count = 0;
+    std::atomic<uint64_t> total_ns = 0;
+    std::array<std::atomic<uint64_t>, HISTOGRAM_BUCKETS> histogram{};
+};
+
+std::atomic<bool> enabled = false;
+std::atomic<FunctionSlot*> table = nullptr;
+
+// Calls which we couldn't find a slot for
+std::atomic<uint64_t> dropped_calls = 0;
+
+std::mutex control_mutex{};
+
+/*
+Startup phases are far less frequent than function calls, so we can get away with just a simple
+list guarded by a mutex. Records are only ever appended, so the index of a phase stays valid.
+*/
+
+struct StartupPhaseRecord {
+    const char* name;
+    size_t depth;
+    std::chrono::steady_clock::time_point start;
+    std::optional<std::chrono::steady_clock::time_point> end;
+};
+
+std::mutex startup_mutex{};
+std::vector<StartupPhaseRecord> startup_phases{};
+size_t startup_depth = 0;
+
+/**
+ * @brief Finds the slot for the given function, claiming a new one if needed.
+ *
+ * @param slots The table of slots to search.
+ * @param func The function to find the slot of.
+ * @return The slot, or nullptr if the table is too full.
+ */
+FunctionSlot* find_slot(FunctionSlot* slots, const UFunction* func) {
+    // Objects are aligned, so drop the low bits, then mix (Fibonacci hashing)
+    const constexpr uint64_t multiplier = 0x9E3779B97F4A7C15;
+    auto hash = (static_cast<uint64_t>(reinterpret_cast<uintptr_t>(func)) >> 4) * multiplier;
+    auto idx = static_cast<size_t>(hash >> (std::numeric_limits<uint64_t>::digits
+                                            - std::bit_width(TABLE_SIZE - 1)));
+
+    for (size_t probe = 0; probe < MAX_PROBES; probe++, idx = (idx + 1) % TABLE_SIZE) {
+        auto& slot = slots[idx];
+
+        auto existing = slot.func.load(std::memory_order_relaxed);
+        if (existing == func) {
+            return &slot;
+        }
+        if (existing != nullptr) {
+            continue;
+        }
+
+        if (slot.func.compare_exchange_strong(existing, func, std::memory_order_relaxed)) {
+            // We claimed this slot, fill in the name. Only do this once per function, since it's
+            // relatively slow.
+            // Since this is called from a destructor, we can't let anything escape
+            try {
+                slot.name = func->get_path_name();
+            } catch (...) {
+                slot.name.clear();
+            }
+            slot.ready.store(true, std::memory_order_release);
+            return &slot;
+        }
+        // Someone else claimed this slot at the same time, if it was for the same function we can
+        // still use it
+        if (existing == func) {
+            return &slot;
+        }
+    }
+
+    return nullptr;
+}
+
+/**
+ * @brief Records a single function call.
+ *
+ * @param func The function which was called.
+ * @param duration How long the call took.
+ */
+void record_call(const UFunction* func, std::chrono::nanoseconds duration) {
+    auto slots = table.load(std::memory_order_acquire);
+    if (slots == nullptr) {
+        return;
+    }
+
+    auto slot = find_slot(slots, func);
+    if (slot == nullptr) {
+        dropped_calls.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    auto ns = static_cast<uint64_t>(std::max<int64_t>(duration.count(), 0));
+    auto bucket = std::min<size_t>(std::bit_width(ns), HISTOGRAM_BUCKETS - 1);
+
+    slot->count.fetch_add(1, std::memory_order_relaxed);
+    slot->total_ns.fetch_add(ns, std::memory_order_relaxed);
+    slot->histogram.at(bucket).fetch_add(1, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Estimates a percentile of a function's call times, based off of it's histogram.
+ *
+ * @param stats The function's stats.
+ * @param percentile The percentile to get, between 0 and 100.
+ * @return The upper bound of the bucket containing the percentile, in nanoseconds.
+ */
+uint64_t estimate_percentile_ns(const FunctionStats& stats, uint64_t percentile) {
+    const constexpr uint64_t max_percentile = 100;
+    auto target = ((stats.count * percentile) + max_percentile - 1) / max_percentile;
+
+    uint64_t seen = 0;
+    for (size_t bucket = 0; bucket < HISTOGRAM_BUCKETS; bucket++) {
+        seen += stats.histogram.at(bucket);
+        if (seen >= target) {
+            return 1ULL << bucket;
+        }
+    }
+    return 1ULL << (HISTOGRAM_BUCKETS - 1);
+}
+
+/**
+ * @brief Logs a table of function stats.
+ *
+ * @param stats The stats to log.
+ */
+void log_stats_table(std::span<const FunctionStats> stats) {
+    const constexpr double ns_per_us = 1000.0;
+    const constexpr double ns_per_ms = 1000000.0;
+
+    LOG(INFO, "{:>10} {:>12} {:>10} {:>10}  {}", "Calls", "Total (ms)", "Mean (us)", "~p99 (us)",
+        "Function");
+    for (const auto& entry : stats) {
+        LOG(INFO, L"{:>10} {:>12.3f} {:>10.3f} {:>10.3f}  {}", entry.count,
+            static_cast<double>(entry.total_ns) / ns_per_ms,
+            static_cast<double>(entry.total_ns) / static_cast<double>(entry.count) / ns_per_us,
+            static_cast<double>(estimate_percentile_ns(entry, 99)) / ns_per_us,
+            *entry.name == L'\0' ? L"<unknown>" : entry.name);
+    }
+}
+
+/**
+ * @brief Logs how many calls weren't profiled.
+ * @note Always logs something, so that a dump makes it obvious whether it's complete or not.
+ */
+void log_dropped_calls(void) {
+    auto dropped = dropped_calls.load(std::memory_order_relaxed);
+    if (dropped > 0) {
+        LOG(WARNING, "{} calls were not profiled, since too many unique functions were called",
+            dropped);
+    } else {
+        LOG(INFO, "No calls were dropped");
+    }
+}
+
+/**
+ * @brief Formats a table of startup phases.
+ *
+ * @param phases The phases to format.
+ * @return The lines of the table.
+ */
+std::vector<std::string> format_startup_phases(std::span<const StartupPhase> phases) {
+    const constexpr double ns_per_ms = 1000000.0;
+    const constexpr size_t indent_per_depth = 2;
+
+    std::vector<std::string> lines{};
+    lines.reserve(phases.size() + 1);
+
+    lines.push_back(std::format("{:>12} {:>12}  {}", "Start (ms)", "Time (ms)", "Phase"));
+    for (const auto& phase : phases) {
+        lines.push_back(std::format("{:>12.3f} {:>12.3f}  {:{}}{}{}",
+                                    static_cast<double>(phase.start_ns) / ns_per_ms,
+                                    static_cast<double>(phase.duration_ns) / ns_per_ms, "",
+                                    phase.depth * indent_per_depth, phase.name,
+                                    phase.finished ? "" : " (running)"));
+    }
+
+    return lines;
+}
+
+/**
+ * @brief Callback for the profile console command.
+ */
+void profile_command(const wchar_t* line, size_t size, size_t cmd_len) {
+    std::wstringstream stream{std::wstring{line + cmd_len, size - cmd_len}};
+    std::wstring action{};
+    stream >> action;
+
+    if (action == L"start") {
+        set_enabled(true);
+        LOG(INFO, "Started profiling function calls");
+    } else if (action == L"stop") {
+        set_enabled(false);
+        LOG(INFO, "Stopped profiling function calls");
+    } else if (action == L"reset") {
+        reset();
+        LOG(INFO, "Reset function call profiling statistics");
+    } else if (action == L"dump") {
+        const constexpr size_t default_count = 20;
+        size_t count = default_count;
+        if (!(stream >> count)) {
+            count = default_count;
+        }
+        dump_function_stats(count);
+    } else if (action == L"startup") {
+        dump_startup_phases();
+    } else {
+        LOG(INFO, "Usage: unrealsdk.profile start|stop|reset|dump [count]|startup");
+    }
+}
+
+}  // namespace
+
+namespace impl {
+
+ScopedCall::ScopedCall(const UFunction* func)
+    : func(enabled.load(std::memory_order_relaxed) ? func : nullptr),
+      start(this->func == nullptr ? std::chrono::steady_clock::time_point{}
+                                  : std::chrono::steady_clock::now()) {}
+
+ScopedCall::~ScopedCall() {
+    if (this->func != nullptr) {
+        record_call(this->func, std::chrono::steady_clock::now() - this->start);
+    }
+}
+
+ScopedStartupPhase::ScopedStartupPhase(const char* name) {
+    const std::scoped_lock lock(startup_mutex);
+
+    this->idx = startup_phases.size();
+    startup_phases.push_back({
+        .name = name,
+        .depth = startup_depth++,
+        .start = std::chrono::steady_clock::now(),
+        .end = std::nullopt,
+    });
+}
+
+ScopedStartupPhase::~ScopedStartupPhase() {
+    auto now = std::chrono::steady_clock::now();
+
+    const std::scoped_lock lock(startup_mutex);
+    startup_phases[this->idx].end = now;
+    startup_depth--;
+}
+
+void log_startup_phases(void) {
+    auto phases = get_startup_phases();
+    if (phases.empty()) {
+        return;
+    }
+
+    LOG(MISC, "Startup phases:");
+    for (const auto& line : format_startup_phases(phases)) {
+        LOG(MISC, "{}", line);
+    }
+}
+
+void register_commands(void) {
+    commands::add_command(L"unrealsdk.profile", &profile_command);
+}
+
+}  // namespace impl
+
+#endif
+#pragma endregion
+
+// =================================================================================================
+
+#pragma region Public Interface
+
+#ifdef UNREALSDK_SHARED
+UNREALSDK_CAPI(void, profiler_set_enabled, bool should_enable);
+#endif
+#ifndef UNREALSDK_IMPORTING
+UNREALSDK_CAPI(void, profiler_set_enabled, bool should_enable) {
+    const std::scoped_lock lock(control_mutex);
+
+    if (should_enable && table.load(std::memory_order_relaxed) == nullptr) {
+        // NOLINTNEXTLINE(cppcoreguidelines-owning-memory)
+        table.store(new FunctionSlot[TABLE_SIZE], std::memory_order_release);
+    }
+    enabled.store(should_enable, std::memory_order_relaxed);
+
+    // The profiler relies on the hook detours, make sure they're running
+    hook_manager::impl::update_hook_detours();
+}
+#endif
+void set_enabled(bool enabled) {
+    UNREALSDK_MANGLE(profiler_set_enabled)(enabled);
+}
+
+#ifdef UNREALSDK_SHARED
+UNREALSDK_CAPI([[nodiscard]] bool, profiler_is_enabled);
+#endif
+#ifndef UNREALSDK_IMPORTING
+UNREALSDK_CAPI([[nodiscard]] bool, profiler_is_enabled) {
+    return enabled.load(std::memory_order_relaxed);
+}
+#endif
+bool is_enabled(void) {
+    return UNREALSDK_MANGLE(profiler_is_enabled)();
+}
+
+#ifdef UNREALSDK_SHARED
+UNREALSDK_CAPI(void, profiler_reset);
+#endif
+#ifndef UNREALSDK_IMPORTING
+UNREALSDK_CAPI(void, profiler_reset) {
+    const std::scoped_lock lock(control_mutex);
+
+    dropped_calls.store(0, std::memory_order_relaxed);
+
+    auto slots = table.load(std::memory_order_acquire);
+    if (slots == nullptr) {
+        return;
+    }
+
+    // Since slots are never released, just zero their counters
+    for (size_t i = 0; i < TABLE_SIZE; i++) {
+        auto& slot = slots[i];
+        slot.count.store(0, std::memory_order_relaxed);
+        slot.total_ns.store(0, std::memory_order_relaxed);
+        for (auto& bucket : slot.histogram) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+    }
+}
+#endif
+void reset(void) {
+    UNREALSDK_MANGLE(profiler_reset)();
+}
+
+#ifdef UNREALSDK_SHARED
+UNREALSDK_CAPI(size_t, profiler_get_function_stats, FunctionStats* stats, size_t max_stats);
+#endif
+#ifndef UNREALSDK_IMPORTING
+UNREALSDK_CAPI(size_t, profiler_get_function_stats, FunctionStats* stats, size_t max_stats) {
+    auto slots = table.load(std::memory_order_acquire);
+    if (slots == nullptr) {
+        return 0;
+    }
+
+    size_t num_stats = 0;
+    for (size_t i = 0; i < TABLE_SIZE; i++) {
+        auto& slot = slots[i];
+        if (!slot.ready.load(std::memory_order_acquire)) {
+            continue;
+        }
+        auto count = slot.count.load(std::memory_order_relaxed);
+        if (count == 0) {
+            continue;
+        }
+
+        if (num_stats < max_stats) {
+            auto& entry = stats[num_stats];
+            entry.func = slot.func.load(std::memory_order_relaxed);
+            entry.name = slot.name.c_str();
+            entry.count = count;
+            entry.total_ns = slot.total_ns.load(std::memory_order_relaxed);
+            std::ranges::transform(slot.histogram, entry.histogram.begin(), [](auto& bucket) {
+                return bucket.load(std::memory_order_relaxed);
+            });
+        }
+        num_stats++;
+    }
+
+    return num_stats;
+}
+#endif
+std::vector<FunctionStats> get_function_stats(void) {
+    std::vector<FunctionStats> stats{};
+
+    // New functions may get called between the two calls, so loop until we get everything
+    size_t num_stats = UNREALSDK_MANGLE(profiler_get_function_stats)(nullptr, 0);
+    do {
+        stats.resize(num_stats);
+        num_stats = UNREALSDK_MANGLE(profiler_get_function_stats)(stats.data(), stats.size());
+    } while (num_stats > stats.size());
+    stats.resize(num_stats);
+
+    return stats;
+}
+
+#ifdef UNREALSDK_SHARED
+UNREALSDK_CAPI(void, profiler_dump_function_stats, size_t count);
+#endif
+#ifndef UNREALSDK_IMPORTING
+UNREALSDK_CAPI(void, profiler_dump_function_stats, size_t count) {
+    auto stats = get_function_stats();
+    if (stats.empty()) {
+        LOG(INFO, "No function calls have been profiled");
+        log_dropped_calls();
+        return;
+    }
+    count = std::min(count, stats.size());
+
+    std::ranges::partial_sort(stats, stats.begin() + static_cast<ptrdiff_t>(count),
+                              std::ranges::greater{}, &FunctionStats::count);
+    LOG(INFO, "Top {} functions by call count:", count);
+    log_stats_table(std::span{stats}.first(count));
+
+    std::ranges::partial_sort(stats, stats.begin() + static_cast<ptrdiff_t>(count),
+                              std::ranges::greater{}, &FunctionStats::total_ns);
+    LOG(INFO, "Top {} functions by total time:", count);
+    log_stats_table(std::span{stats}.first(count));
+
+    log_dropped_calls();
+}
+#endif
+void dump_function_stats(size_t count) {
+    UNREALSDK_MANGLE(profiler_dump_function_stats)(count);
+}
+
+#ifdef UNREALSDK_SHARED
+UNREALSDK_CAPI(size_t, profiler_get_startup_phases, StartupPhase* phases, size_t max_phases);
+#endif
+#ifndef UNREALSDK_IMPORTING
+UNREALSDK_CAPI(size_t, profiler_get_startup_phases, StartupPhase* phases, size_t max_phases) {
+    auto now = std::chrono::steady_clock::now();
+
+    const std::scoped_lock lock(startup_mutex);
+    if (startup_phases.empty()) {
+        return 0;
+    }
+
+    // Report everything relative to the first phase, which should be the whole of init
+    auto origin = startup_phases.front().start;
+    auto to_ns = [](std::chrono::steady_clock::duration duration) {
+        return static_cast<uint64_t>(std::max<int64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count(), 0));
+    };
+
+    auto num_phases = std::min(max_phases, startup_phases.size());
+    for (size_t i = 0; i < num_phases; i++) {
+        const auto& record = startup_phases[i];
+        phases[i] = {
+            .name = record.name,
+            .depth = record.depth,
+            .start_ns = to_ns(record.start - origin),
+            .duration_ns = to_ns(record.end.value_or(now) - record.start),
+            .finished = record.end.has_value(),
+        };
+    }
+
+    return startup_phases.size();
+}
+#endif
+std::vector<StartupPhase> get_startup_phases(void) {
+    std::vector<StartupPhase> phases{};
+
+    // Init may still be adding phases between the two calls, so loop until we get everything
+    size_t num_phases = UNREALSDK_MANGLE(profiler_get_startup_phases)(nullptr, 0);
+    do {
+        phases.resize(num_phases);
+        num_phases = UNREALSDK_MANGLE(profiler_get_startup_phases)(phases.data(), phases.size());
+    } while (num_phases > phases.size());
+    phases.resize(num_phases);
+
+    return phases;
+}
+
+#ifdef UNREALSDK_SHARED
+UNREALSDK_CAPI(void, profiler_dump_startup_phases);
+#endif
+#ifndef UNREALSDK_IMPORTING
+UNREALSDK_CAPI(void, profiler_dump_startup_phases) {
+    auto phases = get_startup_phases();
+    if (phases.empty()) {
+        LOG(INFO, "No startup phases have been recorded");
+        return;
+    }
+
+    LOG(INFO, "Startup phases:");
+    for (const auto& line : format_startup_phases(phases)) {
+        LOG(INFO, "{}", line);
+    }
+}
+#endif
+void dump_startup_phases(void) {
+    UNREALSDK_MANGLE(profiler_dump_startup_phases)();
+}
+
+#pragma endregion
+
+}  // namespace unrealsdk::profiler
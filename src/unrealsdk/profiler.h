@@ -0,0 +1,186 @@
+#ifndef UNREALSDK_PROFILER_H
+#define UNREALSDK_PROFILER_H
+
+#include "unrealsdk/pch.h"
+
+namespace unrealsdk::unreal {
+
+class UFunction;
+
+}  // namespace unrealsdk::unreal
+
+namespace unrealsdk::profiler {
+
+/*
+An opt-in profiler, which counts how often each unreal function is called, and how long each call
+takes. Useful for working out which functions are hot before deciding what to hook, or for finding
+what's eating up frame time.
+
+Timings are inclusive - they cover everything the function does, including any other functions it
+calls, and any hooks which run on it. Recursive calls are counted in full at each level.
+
+Statistics are keyed by function pointer, so if a function gets garbage collected and another one
+created at the same address, they'll be merged, under the name of the first.
+
+This can also be controlled via the `unrealsdk.profile` console command.
+
+Separately, the sdk always times each phase of it's own initialization, so that you can see where
+startup time goes. A breakdown is logged once init finishes, and is also available through
+`get_startup_phases`, or the `unrealsdk.profile startup` console command.
+*/
+
+/// The number of buckets in each function's call time histogram.
+/// Bucket 0 holds calls which took 0ns, bucket i holds calls which took [2^(i-1), 2^i) ns. The last
+/// bucket also holds any longer calls.
+const constexpr size_t HISTOGRAM_BUCKETS = 32;
+
+struct FunctionStats {
+    /// The function these stats are for. May have been garbage collected since, do not dereference.
+    const unreal::UFunction* func;
+    /// The function's full path name, as of when it was first called. Null terminated.
+    const wchar_t* name;
+
+    /// The number of times the function was called.
+    uint64_t count;
+    /// The total time spent in the function, in nanoseconds.
+    uint64_t total_ns;
+    /// A histogram of how long each call took, see `HISTOGRAM_BUCKETS`.
+    std::array<uint64_t, HISTOGRAM_BUCKETS> histogram;
+};
+
+struct StartupPhase {
+    /// The phase's name. Null terminated.
+    const char* name;
+    /// How many other phases this one is nested inside of.
+    size_t depth;
+    /// When the phase started, relative to the start of the first phase, in nanoseconds.
+    uint64_t start_ns;
+    /// How long the phase took, in nanoseconds. If it's still running, how long it's taken so far.
+    uint64_t duration_ns;
+    /// True if the phase has finished.
+    bool finished;
+};
+
+/**
+ * @brief Turns profiling function calls on or off.
+ * @note Statistics are kept when turning it off, and added to when turning it back on.
+ *
+ * @param enabled True to start profiling, false to stop.
+ */
+void set_enabled(bool enabled);
+
+/**
+ * @brief Checks if function calls are currently being profiled.
+ *
+ * @return True if profiling is enabled.
+ */
+[[nodiscard]] bool is_enabled(void);
+
+/**
+ * @brief Clears all collected statistics.
+ */
+void reset(void);
+
+/**
+ * @brief Gets the statistics collected about every function which has been called.
+ * @note Functions are returned in an arbitrary order.
+ *
+ * @return A list of statistics.
+ */
+[[nodiscard]] std::vector<FunctionStats> get_function_stats(void);
+
+/**
+ * @brief Logs the functions with the most calls, and with the most total time.
+ *
+ * @param count How many functions to list in each category.
+ */
+void dump_function_stats(size_t count);
+
+/**
+ * @brief Gets how long each phase of sdk initialization took.
+ * @note Phases are in the order they started, so nested phases come straight after their parent.
+ *
+ * @return A list of phases.
+ */
+[[nodiscard]] std::vector<StartupPhase> get_startup_phases(void);
+
+/**
+ * @brief Logs how long each phase of sdk initialization took.
+ */
+void dump_startup_phases(void);
+
+#ifndef UNREALSDK_IMPORTING
+namespace impl {  // These functions are only relevant when implementing a game hook
+
+/**
+ * @brief RAII class which profiles a single function call, if profiling is enabled.
+ * @note Should be created at the very start of the function call hooks, and live until they return.
+ */
+class [[nodiscard]] ScopedCall {
+   private:
+    const unreal::UFunction* func;
+    std::chrono::steady_clock::time_point start;
+
+   public:
+    explicit ScopedCall(const unreal::UFunction* func);
+    ~ScopedCall();
+
+    ScopedCall(const ScopedCall&) = delete;
+    ScopedCall(ScopedCall&&) = delete;
+    ScopedCall& operator=(const ScopedCall&) = delete;
+    ScopedCall& operator=(ScopedCall&&) = delete;
+};
+
+/**
+ * @brief RAII class which times a single phase of sdk initialization.
+ * @note Phases may be nested, but should all be run on the same thread.
+ */
+class [[nodiscard]] ScopedStartupPhase {
+   private:
+    size_t idx;
+
+   public:
+    /**
+     * @brief Starts a new phase.
+     *
+     * @param name The phase's name. Must have static lifetime.
+     */
+    explicit ScopedStartupPhase(const char* name);
+    ~ScopedStartupPhase();
+
+    ScopedStartupPhase(const ScopedStartupPhase&) = delete;
+    ScopedStartupPhase(ScopedStartupPhase&&) = delete;
+    ScopedStartupPhase& operator=(const ScopedStartupPhase&) = delete;
+    ScopedStartupPhase& operator=(ScopedStartupPhase&&) = delete;
+};
+
+/**
+ * @brief Runs a single step of initialization, timing it as it's own phase.
+ *
+ * @tparam Func The type of the step callback.
+ * @param name The phase's name. Must have static lifetime.
+ * @param func The step to run.
+ */
+template <typename Func>
+void time_startup_phase(const char* name, const Func& func) {
+    const ScopedStartupPhase phase{name};
+    func();
+}
+
+/**
+ * @brief Logs how long each phase of sdk initialization took, at misc level.
+ * @note Intended to be called once at the end of init.
+ */
+void log_startup_phases(void);
+
+/**
+ * @brief Registers the profiler console commands.
+ */
+void register_commands(void);
+
+}  // namespace impl
+#endif
+
+}  // namespace unrealsdk::profiler
+
+#endif /* UNREALSDK_PROFILER_H */
@@ -0,0 +1,947 @@
+// Deliberately doesn't include the pch, see the note in the header
+#include "unrealsdk/sigscan.h"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <concepts>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <thread>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#include <immintrin.h>
+
+// MSVC lets you use any intrinsics anywhere, gcc/clang need to be told which functions use them
+#if defined(__GNUC__) || defined(__clang__)
+#define UNREALSDK_TARGET_SSE2 __attribute__((target("sse2")))
+#define UNREALSDK_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define UNREALSDK_TARGET_SSE2
+#define UNREALSDK_TARGET_AVX2
+#endif
+
+namespace unrealsdk::memory {
+
+#pragma region Sections
+
+namespace {
+
+// Offsets into the PE headers. Parsed by hand, rather than using the windows structs, so that this
+// works the same on any buffer on any platform.
+const constexpr size_t DOS_E_LFANEW_OFFSET = 0x3C;
+const constexpr uint32_t PE_SIGNATURE = 0x00004550;  // "PE\0\0"
+const constexpr size_t PE_SIGNATURE_SIZE = 4;
+const constexpr size_t FILE_HEADER_NUMBER_OF_SECTIONS_OFFSET = 2;
+const constexpr size_t FILE_HEADER_SIZE_OF_OPTIONAL_HEADER_OFFSET = 16;
+const constexpr size_t FILE_HEADER_SIZE = 20;
+const constexpr size_t SECTION_HEADER_VIRTUAL_SIZE_OFFSET = 8;
+const constexpr size_t SECTION_HEADER_VIRTUAL_ADDRESS_OFFSET = 12;
+const constexpr size_t SECTION_HEADER_SIZE_OF_RAW_DATA_OFFSET = 16;
+const constexpr size_t SECTION_HEADER_CHARACTERISTICS_OFFSET = 36;
+const constexpr size_t SECTION_HEADER_SIZE = 40;
+
+const constexpr uint32_t SECTION_CNT_CODE = 0x00000020;
+const constexpr uint32_t SECTION_CNT_INITIALIZED_DATA = 0x00000040;
+const constexpr uint32_t SECTION_MEM_EXECUTE = 0x20000000;
+
+/**
+ * @brief Reads a little endian integer out of a buffer, with bounds checking.
+ *
+ * @tparam T The type of integer to read.
+ * @param buffer The buffer to read from.
+ * @param offset The offset to read at.
+ * @return The read value, or std::nullopt if it's out of bounds.
+ */
+template <std::integral T>
+std::optional<T> read_le(std::span<const uint8_t> buffer, size_t offset) {
+    if (offset > buffer.size() || buffer.size() - offset < sizeof(T)) {
+        return std::nullopt;
+    }
+    T value{};
+    for (size_t i = 0; i < sizeof(T); i++) {
+        value |= static_cast<T>(static_cast<T>(buffer[offset + i]) << (i * 8));
+    }
+    return value;
+}
+
+}  // namespace
+
+bool Section::is_type(SectionType type) const {
+    auto executable = (this->characteristics & (SECTION_MEM_EXECUTE | SECTION_CNT_CODE)) != 0;
+    switch (type) {
+        case SectionType::CODE:
+            return executable;
+        case SectionType::DATA:
+            return !executable && (this->characteristics & SECTION_CNT_INITIALIZED_DATA) != 0;
+        case SectionType::ANY:
+        default:
+            return true;
+    }
+}
+
+std::vector<Section> parse_sections(std::span<const uint8_t> image) {
+    auto e_lfanew = read_le<uint32_t>(image, DOS_E_LFANEW_OFFSET);
+    if (!e_lfanew.has_value() || read_le<uint32_t>(image, *e_lfanew) != PE_SIGNATURE) {
+        return {};
+    }
+
+    auto file_header = static_cast<size_t>(*e_lfanew) + PE_SIGNATURE_SIZE;
+    auto section_count =
+        read_le<uint16_t>(image, file_header + FILE_HEADER_NUMBER_OF_SECTIONS_OFFSET);
+    auto optional_header_size =
+        read_le<uint16_t>(image, file_header + FILE_HEADER_SIZE_OF_OPTIONAL_HEADER_OFFSET);
+    if (!section_count.has_value() || !optional_header_size.has_value()) {
+        return {};
+    }
+
+    auto section_table = file_header + FILE_HEADER_SIZE + *optional_header_size;
+
+    std::vector<Section> sections{};
+    sections.reserve(*section_count);
+    for (size_t i = 0; i < *section_count; i++) {
+        auto header = section_table + (i * SECTION_HEADER_SIZE);
+        auto virtual_size = read_le<uint32_t>(image, header + SECTION_HEADER_VIRTUAL_SIZE_OFFSET);
+        auto rva = read_le<uint32_t>(image, header + SECTION_HEADER_VIRTUAL_ADDRESS_OFFSET);
+        auto raw_size = read_le<uint32_t>(image, header + SECTION_HEADER_SIZE_OF_RAW_DATA_OFFSET);
+        auto characteristics =
+            read_le<uint32_t>(image, header + SECTION_HEADER_CHARACTERISTICS_OFFSET);
+        if (!virtual_size.has_value() || !rva.has_value() || !raw_size.has_value()
+            || !characteristics.has_value()) {
+            // Truncated section table, assume it's not a valid image
+            return {};
+        }
+
+        Section section{.name = {},
+                        .rva = *rva,
+                        // Some linkers leave the virtual size as 0
+                        .size = *virtual_size != 0 ? *virtual_size : *raw_size,
+                        .characteristics = *characteristics};
+        std::copy_n(reinterpret_cast<const char*>(&image[header]), section.name.size(),
+                    section.name.begin());
+        sections.push_back(section);
+    }
+
+    return sections;
+}
+
+#pragma endregion
+
+namespace engine {
+
+namespace {
+
+#pragma region Sigscan
+
+/*
+Sigscanning is dominated by rejecting positions which don't match. Rather than trying to match the
+whole pattern at every single position, the vectorized scanners pick a single "anchor" byte out of
+the pattern, which must be fully masked, and compare it against 16/32 positions at once. Only
+positions where the anchor matches get the full (masked, also vectorized) comparison.
+
+To make that as effective as possible, the anchor should be a byte which is rare in the exe. Code is
+very far from uniformly distributed, so we avoid the bytes which are most common in x86 code.
+
+All scanners check positions in increasing order, and return the first match, so they give
+identical results.
+*/
+
+// Roughly the most common bytes in x86 code, most common first
+const constexpr std::array<uint8_t, 24> COMMON_CODE_BYTES = {
+    0x00, 0xFF, 0x48, 0x8B, 0x89, 0x24, 0x4C, 0xCC, 0xE8, 0x0F, 0x44, 0x85,
+    0x01, 0x83, 0xC0, 0x8D, 0x74, 0x10, 0x08, 0x20, 0x75, 0x40, 0x41, 0xC3,
+};
+
+const constexpr auto NO_ANCHOR = std::numeric_limits<size_t>::max();
+
+const constexpr size_t VERIFY_CHUNK_SIZE = 16;
+
+/**
+ * @brief Picks which byte of a pattern to use as the anchor.
+ *
+ * @param bytes The bytes to search for.
+ * @param mask The mask over the bytes to search for.
+ * @param pattern_size The size of the bytes + mask.
+ * @return The index of the anchor byte, or `NO_ANCHOR` if no byte is fully masked.
+ */
+size_t pick_anchor(const uint8_t* bytes, const uint8_t* mask, size_t pattern_size) {
+    size_t best_idx = NO_ANCHOR;
+    size_t best_rank = 0;
+    for (size_t i = 0; i < pattern_size; i++) {
+        if (mask[i] != std::numeric_limits<uint8_t>::max()) {
+            continue;
+        }
+
+        // Anything not in the common list ranks above everything in it
+        auto rank = static_cast<size_t>(std::distance(
+            COMMON_CODE_BYTES.begin(), std::ranges::find(COMMON_CODE_BYTES, bytes[i])));
+        if (best_idx == NO_ANCHOR || rank > best_rank) {
+            best_idx = i;
+            best_rank = rank;
+        }
+    }
+    return best_idx;
+}
+
+/**
+ * @brief Checks if a pattern matches at the given address, one byte at a time.
+ *
+ * @param data The address to check.
+ * @param bytes The bytes to search for.
+ * @param mask The mask over the bytes to search for.
+ * @param pattern_size The size of the bytes + mask.
+ * @return True if the pattern matches.
+ */
+bool matches_at(const uint8_t* data,
+                const uint8_t* bytes,
+                const uint8_t* mask,
+                size_t pattern_size) {
+    for (size_t j = 0; j < pattern_size; j++) {
+        if ((data[j] & mask[j]) != bytes[j]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Performs a sigscan using the naive byte-by-byte O(nm) search.
+ * @note Used for patterns without any fully masked bytes, or on cpus without SSE2.
+ *
+ * @param bytes The bytes to search for.
+ * @param mask The mask over the bytes to search for.
+ * @param pattern_size The size of the bytes + mask.
+ * @param start The address to start the search at.
+ * @param size The length of the region to search.
+ * @return The found location, or 0.
+ */
+uintptr_t sigscan_scalar(const uint8_t* bytes,
+                         const uint8_t* mask,
+                         size_t pattern_size,
+                         uintptr_t start,
+                         size_t size) {
+    auto start_ptr = reinterpret_cast<uint8_t*>(start);
+    for (size_t i = 0; i < (size - pattern_size); i++) {
+        if (matches_at(&start_ptr[i], bytes, mask, pattern_size)) {
+            return reinterpret_cast<uintptr_t>(&start_ptr[i]);
+        }
+    }
+    return 0;
+}
+
+/// A pattern, padded out to a whole number of vector verify chunks.
+struct PaddedPattern {
+    const uint8_t* bytes;
+    const uint8_t* mask;
+    size_t size;
+    size_t anchor;
+
+    // The padding is all wildcards, so matches anything
+    std::vector<uint8_t> padded_bytes;
+    std::vector<uint8_t> padded_mask;
+
+    PaddedPattern(const uint8_t* bytes, const uint8_t* mask, size_t size, size_t anchor)
+        : bytes(bytes),
+          mask(mask),
+          size(size),
+          anchor(anchor),
+          padded_bytes(((size + VERIFY_CHUNK_SIZE - 1) / VERIFY_CHUNK_SIZE) * VERIFY_CHUNK_SIZE),
+          padded_mask(padded_bytes.size()) {
+        std::copy_n(bytes, size, this->padded_bytes.begin());
+        std::copy_n(mask, size, this->padded_mask.begin());
+    }
+};
+
+/**
+ * @brief Checks if a pattern matches at the given address, 16 bytes at a time.
+ * @note There's an identical AVX2 version, so that AVX2 scans don't keep switching between VEX and
+ *       legacy SSE encodings, which is very slow on some cpus.
+ *
+ * @param data The address to check.
+ * @param data_end The end of the region being searched, which must not be read past.
+ * @param pattern The pattern to check.
+ * @return True if the pattern matches.
+ */
+UNREALSDK_TARGET_SSE2 bool matches_at_sse2(const uint8_t* data,
+                                           const uint8_t* data_end,
+                                           const PaddedPattern& pattern) {
+    // Can't read a full chunk past the end of the region, fall back to checking byte by byte
+    if (static_cast<size_t>(data_end - data) < pattern.padded_bytes.size()) {
+        return matches_at(data, pattern.bytes, pattern.mask, pattern.size);
+    }
+
+    for (size_t j = 0; j < pattern.padded_bytes.size(); j += VERIFY_CHUNK_SIZE) {
+        auto chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&data[j]));
+        auto chunk_mask =
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(&pattern.padded_mask[j]));
+        auto chunk_bytes =
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(&pattern.padded_bytes[j]));
+
+        auto eq = _mm_cmpeq_epi8(_mm_and_si128(chunk, chunk_mask), chunk_bytes);
+        if (_mm_movemask_epi8(eq) != 0xFFFF) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Checks if a pattern matches at the given address, 16 bytes at a time, using AVX2
+ *        encodings. See `matches_at_sse2`.
+ *
+ * @param data The address to check.
+ * @param data_end The end of the region being searched, which must not be read past.
+ * @param pattern The pattern to check.
+ * @return True if the pattern matches.
+ */
+UNREALSDK_TARGET_AVX2 bool matches_at_avx2(const uint8_t* data,
+                                           const uint8_t* data_end,
+                                           const PaddedPattern& pattern) {
+    // Can't read a full chunk past the end of the region, fall back to checking byte by byte
+    if (static_cast<size_t>(data_end - data) < pattern.padded_bytes.size()) {
+        return matches_at(data, pattern.bytes, pattern.mask, pattern.size);
+    }
+
+    for (size_t j = 0; j < pattern.padded_bytes.size(); j += VERIFY_CHUNK_SIZE) {
+        auto chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&data[j]));
+        auto chunk_mask =
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(&pattern.padded_mask[j]));
+        auto chunk_bytes =
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(&pattern.padded_bytes[j]));
+
+        auto eq = _mm_cmpeq_epi8(_mm_and_si128(chunk, chunk_mask), chunk_bytes);
+        if (_mm_movemask_epi8(eq) != 0xFFFF) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Performs a sigscan, checking the anchor byte at 16 positions at once.
+ *
+ * @param pattern The pattern to search for.
+ * @param start The address to start the search at.
+ * @param size The length of the region to search.
+ * @return The found location, or 0.
+ */
+UNREALSDK_TARGET_SSE2 uintptr_t sigscan_sse2(const PaddedPattern& pattern,
+                                             uintptr_t start,
+                                             size_t size) {
+    const auto* start_ptr = reinterpret_cast<const uint8_t*>(start);
+    const auto* end_ptr = start_ptr + size;
+    const auto last = size - pattern.size;
+
+    auto needle = _mm_set1_epi8(static_cast<char>(pattern.bytes[pattern.anchor]));
+
+    size_t i = 0;
+    for (; i + sizeof(__m128i) <= last; i += sizeof(__m128i)) {
+        auto block =
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(&start_ptr[i + pattern.anchor]));
+        auto hits = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, needle)));
+        while (hits != 0) {
+            auto candidate = i + static_cast<size_t>(std::countr_zero(hits));
+            if (matches_at_sse2(&start_ptr[candidate], end_ptr, pattern)) {
+                return reinterpret_cast<uintptr_t>(&start_ptr[candidate]);
+            }
+            hits &= hits - 1;
+        }
+    }
+
+    for (; i < last; i++) {
+        if (matches_at(&start_ptr[i], pattern.bytes, pattern.mask, pattern.size)) {
+            return reinterpret_cast<uintptr_t>(&start_ptr[i]);
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Performs a sigscan, checking the anchor byte at 32 positions at once.
+ *
+ * @param pattern The pattern to search for.
+ * @param start The address to start the search at.
+ * @param size The length of the region to search.
+ * @return The found location, or 0.
+ */
+UNREALSDK_TARGET_AVX2 uintptr_t sigscan_avx2(const PaddedPattern& pattern,
+                                             uintptr_t start,
+                                             size_t size) {
+    const auto* start_ptr = reinterpret_cast<const uint8_t*>(start);
+    const auto* end_ptr = start_ptr + size;
+    const auto last = size - pattern.size;
+
+    auto needle = _mm256_set1_epi8(static_cast<char>(pattern.bytes[pattern.anchor]));
+
+    size_t i = 0;
+    for (; i + sizeof(__m256i) <= last; i += sizeof(__m256i)) {
+        auto block =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&start_ptr[i + pattern.anchor]));
+        auto hits = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, needle)));
+        while (hits != 0) {
+            auto candidate = i + static_cast<size_t>(std::countr_zero(hits));
+            if (matches_at_avx2(&start_ptr[candidate], end_ptr, pattern)) {
+                return reinterpret_cast<uintptr_t>(&start_ptr[candidate]);
+            }
+            hits &= hits - 1;
+        }
+    }
+
+    for (; i < last; i++) {
+        if (matches_at(&start_ptr[i], pattern.bytes, pattern.mask, pattern.size)) {
+            return reinterpret_cast<uintptr_t>(&start_ptr[i]);
+        }
+    }
+    return 0;
+}
+
+#pragma endregion
+
+#pragma region Multi-Pattern Sigscan
+
+/*
+When scanning for several patterns at once, rather than looking for a single anchor byte, we look
+for any of their anchor bytes in one pass. Whenever one is found, we check every pattern anchored on
+that byte value, positioning each so that it's anchor lines up.
+
+Since each individual pattern's candidates are still checked in increasing address order, each
+still finds the same matches it would have when scanned on it's own.
+*/
+
+struct MultiSigscan {
+    std::vector<PaddedPattern> patterns;
+    std::vector<size_t> results;
+    // How many matches to find for each pattern before we stop checking it
+    size_t max_matches = 1;
+    size_t remaining = 0;
+
+    // The indexes of the patterns anchored on each byte value
+    std::array<std::vector<size_t>, std::numeric_limits<uint8_t>::max() + 1> by_anchor;
+    // All distinct anchor byte values
+    std::vector<uint8_t> needles;
+
+    /**
+     * @brief Adds a pattern to the scan.
+     *
+     * @param pattern The pattern to add. Must have an anchor.
+     * @param result_idx The index of the result this pattern should write to.
+     */
+    void add(PaddedPattern&& pattern, size_t result_idx) {
+        auto anchor_byte = pattern.bytes[pattern.anchor];
+        auto& anchored = this->by_anchor.at(anchor_byte);
+        if (anchored.empty()) {
+            this->needles.push_back(anchor_byte);
+        }
+        anchored.push_back(this->patterns.size());
+
+        this->patterns.push_back(std::move(pattern));
+        this->results.push_back(result_idx);
+        this->remaining++;
+    }
+
+    /**
+     * @brief Checks all patterns anchored on the byte at the given position.
+     *
+     * @param start_ptr The start of the region being searched.
+     * @param size The length of the region being searched.
+     * @param pos The position of the anchor byte to check.
+     * @param results The list of matches for each pattern to append to.
+     * @return True once every pattern has been found enough times.
+     */
+    bool check_anchor(const uint8_t* start_ptr,
+                      size_t size,
+                      size_t pos,
+                      std::vector<std::vector<uintptr_t>>& results) {
+        for (auto idx : this->by_anchor.at(start_ptr[pos])) {
+            const auto& pattern = this->patterns[idx];
+            auto& matches = results[this->results[idx]];
+            if (matches.size() >= this->max_matches || pos < pattern.anchor) {
+                continue;
+            }
+            auto candidate = pos - pattern.anchor;
+            // Same end bound as the single pattern scan
+            if (candidate >= size - pattern.size) {
+                continue;
+            }
+
+            if (matches_at(&start_ptr[candidate], pattern.bytes, pattern.mask, pattern.size)) {
+                matches.push_back(reinterpret_cast<uintptr_t>(&start_ptr[candidate]));
+                if (matches.size() >= this->max_matches) {
+                    this->remaining--;
+                }
+            }
+        }
+        return this->remaining == 0;
+    }
+};
+
+/**
+ * @brief Scans for several patterns, checking for any anchor byte at 16 positions at once.
+ *
+ * @param scan The patterns to search for.
+ * @param start The address to start the search at.
+ * @param size The length of the region to search.
+ * @param results The list of matches for each pattern to append to.
+ */
+UNREALSDK_TARGET_SSE2 void multi_sigscan_sse2(MultiSigscan& scan,
+                                              uintptr_t start,
+                                              size_t size,
+                                              std::vector<std::vector<uintptr_t>>& results) {
+    const auto* start_ptr = reinterpret_cast<const uint8_t*>(start);
+
+    // Can't put vector types in a std container without losing their alignment attributes
+    __m128i needles[std::numeric_limits<uint8_t>::max() + 1];
+    auto needle_count = scan.needles.size();
+    for (size_t j = 0; j < needle_count; j++) {
+        needles[j] = _mm_set1_epi8(static_cast<char>(scan.needles[j]));
+    }
+
+    size_t i = 0;
+    for (; i + sizeof(__m128i) <= size; i += sizeof(__m128i)) {
+        auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&start_ptr[i]));
+        auto any_eq = _mm_setzero_si128();
+        for (size_t j = 0; j < needle_count; j++) {
+            any_eq = _mm_or_si128(any_eq, _mm_cmpeq_epi8(block, needles[j]));
+        }
+
+        auto hits = static_cast<uint32_t>(_mm_movemask_epi8(any_eq));
+        while (hits != 0) {
+            auto pos = i + static_cast<size_t>(std::countr_zero(hits));
+            if (scan.check_anchor(start_ptr, size, pos, results)) {
+                return;
+            }
+            hits &= hits - 1;
+        }
+    }
+
+    for (; i < size; i++) {
+        if (scan.check_anchor(start_ptr, size, i, results)) {
+            return;
+        }
+    }
+}
+
+/**
+ * @brief Scans for several patterns, checking for any anchor byte at 32 positions at once.
+ *
+ * @param scan The patterns to search for.
+ * @param start The address to start the search at.
+ * @param size The length of the region to search.
+ * @param results The list of matches for each pattern to append to.
+ */
+UNREALSDK_TARGET_AVX2 void multi_sigscan_avx2(MultiSigscan& scan,
+                                              uintptr_t start,
+                                              size_t size,
+                                              std::vector<std::vector<uintptr_t>>& results) {
+    const auto* start_ptr = reinterpret_cast<const uint8_t*>(start);
+
+    // Can't put vector types in a std container without losing their alignment attributes
+    __m256i needles[std::numeric_limits<uint8_t>::max() + 1];
+    auto needle_count = scan.needles.size();
+    for (size_t j = 0; j < needle_count; j++) {
+        needles[j] = _mm256_set1_epi8(static_cast<char>(scan.needles[j]));
+    }
+
+    size_t i = 0;
+    for (; i + sizeof(__m256i) <= size; i += sizeof(__m256i)) {
+        auto block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&start_ptr[i]));
+        auto any_eq = _mm256_setzero_si256();
+        for (size_t j = 0; j < needle_count; j++) {
+            any_eq = _mm256_or_si256(any_eq, _mm256_cmpeq_epi8(block, needles[j]));
+        }
+
+        auto hits = static_cast<uint32_t>(_mm256_movemask_epi8(any_eq));
+        while (hits != 0) {
+            auto pos = i + static_cast<size_t>(std::countr_zero(hits));
+            if (scan.check_anchor(start_ptr, size, pos, results)) {
+                return;
+            }
+            hits &= hits - 1;
+        }
+    }
+
+    for (; i < size; i++) {
+        if (scan.check_anchor(start_ptr, size, i, results)) {
+            return;
+        }
+    }
+}
+
+#pragma endregion
+
+#pragma region Parallel Sigscan
+
+/*
+Large regions (i.e. the whole exe) get split into chunks, which are scanned on several threads.
+
+Each chunk covers a fixed range of candidate positions, but extends past it by the pattern size, so
+that a match starting near the end of the chunk can still be read in full. Chunks are handed out in
+increasing address order, and each chunk's matches are stored separately and merged in order
+afterwards, so results are always the same as a single threaded scan. Once a chunk has found enough
+matches, any later chunks are skipped.
+*/
+
+// The number of candidate positions in each chunk
+const constexpr size_t SIGSCAN_CHUNK_SIZE = 4ULL * 1024 * 1024;
+
+/**
+ * @brief Gets how many chunks a region gets split into.
+ *
+ * @param size The length of the region to search.
+ * @param overlap How far each chunk extends past the last candidate position it covers.
+ * @return The number of chunks.
+ */
+size_t get_chunk_count(size_t size, size_t overlap) {
+    return (size - overlap + SIGSCAN_CHUNK_SIZE - 1) / SIGSCAN_CHUNK_SIZE;
+}
+
+/**
+ * @brief Atomically lowers a value, if the new value is lower.
+ *
+ * @param target The atomic to update.
+ * @param value The new value.
+ */
+void store_min(std::atomic<uintptr_t>& target, uintptr_t value) {
+    auto current = target.load(std::memory_order_relaxed);
+    while (value < current
+           && !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {}
+}
+
+/**
+ * @brief Splits a region into overlapping chunks, and scans them across several threads.
+ *
+ * @tparam ScanChunk The type of the chunk callback.
+ * @param start The address to start the search at.
+ * @param size The length of the region to search.
+ * @param overlap How far each chunk extends past the last candidate position it covers.
+ * @param thread_count The number of threads to use, including the calling thread.
+ * @param scan_chunk Callback to scan a single chunk, taking it's index, start address, and length.
+ *                   Called concurrently.
+ */
+template <typename ScanChunk>
+void scan_chunks(uintptr_t start,
+                 size_t size,
+                 size_t overlap,
+                 size_t thread_count,
+                 const ScanChunk& scan_chunk) {
+    auto candidates = size - overlap;
+    auto chunk_count = get_chunk_count(size, overlap);
+
+    std::atomic<size_t> next_chunk = 0;
+    auto worker = [&]() {
+        for (auto chunk = next_chunk.fetch_add(1, std::memory_order_relaxed); chunk < chunk_count;
+             chunk = next_chunk.fetch_add(1, std::memory_order_relaxed)) {
+            auto offset = chunk * SIGSCAN_CHUNK_SIZE;
+            scan_chunk(chunk, start + offset,
+                       std::min(SIGSCAN_CHUNK_SIZE, candidates - offset) + overlap);
+        }
+    };
+
+    auto worker_count = std::min(thread_count, chunk_count);
+    std::vector<std::jthread> workers{};
+    workers.reserve(worker_count - 1);
+    for (size_t i = 1; i < worker_count; i++) {
+        workers.emplace_back(worker);
+    }
+
+    // Might as well help out rather than just waiting
+    worker();
+
+    // The jthreads join when they go out of scope
+}
+
+/**
+ * @brief Merges the matches found in each chunk, in chunk order.
+ *
+ * @param chunk_matches The matches found in each chunk. Chunks which weren't scanned may be empty.
+ * @param max_matches The max number of matches to keep.
+ * @return The merged matches.
+ */
+std::vector<uintptr_t> merge_chunk_matches(const std::vector<std::vector<uintptr_t>>& chunk_matches,
+                                           size_t max_matches) {
+    std::vector<uintptr_t> matches{};
+    for (const auto& chunk : chunk_matches) {
+        for (auto address : chunk) {
+            // Chunks overlap, so a short pattern may get found at the start of the next chunk too
+            if (!matches.empty() && address <= matches.back()) {
+                continue;
+            }
+            matches.push_back(address);
+            if (matches.size() >= max_matches) {
+                return matches;
+            }
+        }
+    }
+    return matches;
+}
+
+#pragma endregion
+
+}  // namespace
+
+SigscanImpl detect_sigscan_impl(void) {
+    const constexpr uint32_t leaf1_edx_sse2 = 1U << 26;
+    const constexpr uint32_t leaf1_ecx_osxsave = 1U << 27;
+    const constexpr uint32_t leaf1_ecx_avx = 1U << 28;
+    const constexpr uint32_t leaf7_ebx_avx2 = 1U << 5;
+    const constexpr uint64_t xcr0_sse_avx_state = 0b110;
+
+    std::array<uint32_t, 4> leaf1{};
+    std::array<uint32_t, 4> leaf7{};
+#ifdef _MSC_VER
+    std::array<int, 4> regs{};
+    __cpuid(regs.data(), 0);
+    auto max_leaf = regs[0];
+    __cpuid(regs.data(), 1);
+    std::ranges::copy(regs, leaf1.begin());
+    if (max_leaf >= 7) {
+        __cpuidex(regs.data(), 7, 0);
+        std::ranges::copy(regs, leaf7.begin());
+    }
+#else
+    auto max_leaf = __get_cpuid_max(0, nullptr);
+    __get_cpuid(1, &leaf1[0], &leaf1[1], &leaf1[2], &leaf1[3]);
+    if (max_leaf >= 7) {
+        __get_cpuid_count(7, 0, &leaf7[0], &leaf7[1], &leaf7[2], &leaf7[3]);
+    }
+#endif
+
+    // AVX2 also needs the OS to save the upper halves of the registers
+    if ((leaf1[2] & leaf1_ecx_osxsave) != 0 && (leaf1[2] & leaf1_ecx_avx) != 0
+        && (leaf7[1] & leaf7_ebx_avx2) != 0) {
+#ifdef _MSC_VER
+        auto xcr0 = _xgetbv(0);
+#else
+        uint32_t xcr0_low{};
+        uint32_t xcr0_high{};
+        __asm__("xgetbv" : "=a"(xcr0_low), "=d"(xcr0_high) : "c"(0));
+        auto xcr0 = (static_cast<uint64_t>(xcr0_high) << 32) | xcr0_low;
+#endif
+        if ((xcr0 & xcr0_sse_avx_state) == xcr0_sse_avx_state) {
+            return SigscanImpl::AVX2;
+        }
+    }
+    if ((leaf1[3] & leaf1_edx_sse2) != 0) {
+        return SigscanImpl::SSE2;
+    }
+    return SigscanImpl::SCALAR;
+}
+
+std::string_view get_sigscan_impl_name(SigscanImpl impl) {
+    switch (impl) {
+        case SigscanImpl::AVX2:
+            return "AVX2";
+        case SigscanImpl::SSE2:
+            return "SSE2";
+        case SigscanImpl::SCALAR:
+        default:
+            return "scalar";
+    }
+}
+
+bool matches_at(const uint8_t* data, const PatternView& pattern) {
+    return matches_at(data, pattern.bytes, pattern.mask, pattern.size);
+}
+
+uintptr_t sigscan(const PatternView& pattern,
+                  uintptr_t start,
+                  size_t size,
+                  SigscanImpl impl,
+                  size_t thread_count) {
+    auto matches = sigscan_all(pattern, start, size, impl, thread_count, 1);
+    return matches.empty() ? 0 : matches.front();
+}
+
+std::vector<uintptr_t> sigscan_all(const PatternView& pattern,
+                                   uintptr_t start,
+                                   size_t size,
+                                   SigscanImpl impl,
+                                   size_t thread_count,
+                                   size_t max_matches) {
+    const auto* bytes = pattern.bytes;
+    const auto* mask = pattern.mask;
+    auto pattern_size = pattern.size;
+    if (size <= pattern_size || max_matches == 0) {
+        return {};
+    }
+
+    auto anchor = pick_anchor(bytes, mask, pattern_size);
+
+    std::optional<PaddedPattern> padded{};
+    if (impl != SigscanImpl::SCALAR && anchor != NO_ANCHOR) {
+        padded.emplace(bytes, mask, pattern_size, anchor);
+    }
+
+    auto scan_region = [&](uintptr_t region_start, size_t region_size) {
+        std::vector<uintptr_t> matches{};
+
+        // Rather than scanning again to look for more matches, just pick up from where the last one
+        // left off, so that this is still a single pass over memory
+        auto region_end = region_start + region_size;
+        while (matches.size() < max_matches && region_end - region_start > pattern_size) {
+            uintptr_t result{};
+            if (!padded.has_value()) {
+                result = sigscan_scalar(bytes, mask, pattern_size, region_start,
+                                        region_end - region_start);
+            } else if (impl == SigscanImpl::AVX2) {
+                result = sigscan_avx2(*padded, region_start, region_end - region_start);
+            } else {
+                result = sigscan_sse2(*padded, region_start, region_end - region_start);
+            }
+
+            if (result == 0) {
+                break;
+            }
+            matches.push_back(result);
+            region_start = result + 1;
+        }
+
+        return matches;
+    };
+
+    if (thread_count <= 1 || size < MIN_PARALLEL_SIGSCAN_SIZE) {
+        return scan_region(start, size);
+    }
+
+    std::vector<std::vector<uintptr_t>> chunk_matches(get_chunk_count(size, pattern_size));
+    // The start of the first chunk which found enough matches on it's own
+    std::atomic<uintptr_t> cutoff = std::numeric_limits<uintptr_t>::max();
+    scan_chunks(start, size, pattern_size, thread_count,
+                [&](size_t chunk_idx, uintptr_t chunk_start, size_t chunk_size) {
+                    // Anything in this chunk would be after what we've already found
+                    if (cutoff.load(std::memory_order_relaxed) < chunk_start) {
+                        return;
+                    }
+                    auto& matches = chunk_matches[chunk_idx];
+                    matches = scan_region(chunk_start, chunk_size);
+                    if (matches.size() >= max_matches) {
+                        store_min(cutoff, chunk_start);
+                    }
+                });
+
+    return merge_chunk_matches(chunk_matches, max_matches);
+}
+
+std::vector<uintptr_t> sigscan_many(std::span<const PatternView> patterns,
+                                    uintptr_t start,
+                                    size_t size,
+                                    SigscanImpl impl,
+                                    size_t thread_count) {
+    auto matches = sigscan_many_all(patterns, start, size, impl, thread_count, 1);
+
+    std::vector<uintptr_t> results(patterns.size());
+    for (size_t i = 0; i < patterns.size(); i++) {
+        if (!matches[i].empty()) {
+            results[i] = matches[i].front();
+        }
+    }
+    return results;
+}
+
+std::vector<std::vector<uintptr_t>> sigscan_many_all(std::span<const PatternView> patterns,
+                                                     uintptr_t start,
+                                                     size_t size,
+                                                     SigscanImpl impl,
+                                                     size_t thread_count,
+                                                     size_t max_matches) {
+    std::vector<std::vector<uintptr_t>> results(patterns.size());
+    if (max_matches == 0) {
+        return results;
+    }
+
+    std::vector<size_t> anchors(patterns.size());
+    std::vector<size_t> combined{};
+    size_t max_pattern_size = 0;
+    for (size_t i = 0; i < patterns.size(); i++) {
+        const auto& pattern = patterns[i];
+        if (size <= pattern.size) {
+            continue;
+        }
+
+        anchors[i] = pick_anchor(pattern.bytes, pattern.mask, pattern.size);
+        if (impl == SigscanImpl::SCALAR || anchors[i] == NO_ANCHOR) {
+            // Without an anchor, we can't include it in the combined pass
+            results[i] = sigscan_all(pattern, start, size, impl, thread_count, max_matches);
+            continue;
+        }
+        combined.push_back(i);
+        max_pattern_size = std::max(max_pattern_size, pattern.size);
+    }
+
+    if (combined.empty()) {
+        return results;
+    }
+
+    auto scan_region = [&](uintptr_t region_start, size_t region_size,
+                           std::span<const size_t> indexes,
+                           std::vector<std::vector<uintptr_t>>& region_results) {
+        MultiSigscan scan{};
+        scan.max_matches = max_matches;
+        for (auto idx : indexes) {
+            const auto& pattern = patterns[idx];
+            scan.add({pattern.bytes, pattern.mask, pattern.size, anchors[idx]}, idx);
+        }
+
+        if (impl == SigscanImpl::AVX2) {
+            multi_sigscan_avx2(scan, region_start, region_size, region_results);
+        } else {
+            multi_sigscan_sse2(scan, region_start, region_size, region_results);
+        }
+    };
+
+    if (thread_count <= 1 || size < MIN_PARALLEL_SIGSCAN_SIZE) {
+        scan_region(start, size, combined, results);
+        return results;
+    }
+
+    // Each chunk extends by the largest pattern, so that it covers every pattern's candidates
+    std::vector<std::vector<std::vector<uintptr_t>>> chunk_results(
+        get_chunk_count(size, max_pattern_size));
+    // The start of the first chunk which found enough matches of each pattern on it's own
+    std::vector<std::atomic<uintptr_t>> cutoffs(patterns.size());
+    for (auto& address : cutoffs) {
+        address.store(std::numeric_limits<uintptr_t>::max(), std::memory_order_relaxed);
+    }
+    scan_chunks(start, size, max_pattern_size, thread_count,
+                [&](size_t chunk_idx, uintptr_t chunk_start, size_t chunk_size) {
+                    // Skip any patterns we've already found enough of before this chunk
+                    std::vector<size_t> remaining{};
+                    for (auto idx : combined) {
+                        if (cutoffs[idx].load(std::memory_order_relaxed) > chunk_start) {
+                            remaining.push_back(idx);
+                        }
+                    }
+                    if (remaining.empty()) {
+                        return;
+                    }
+
+                    auto& chunk_matches = chunk_results[chunk_idx];
+                    chunk_matches.resize(patterns.size());
+                    scan_region(chunk_start, chunk_size, remaining, chunk_matches);
+                    for (auto idx : remaining) {
+                        if (chunk_matches[idx].size() >= max_matches) {
+                            store_min(cutoffs[idx], chunk_start);
+                        }
+                    }
+                });
+
+    std::vector<std::vector<uintptr_t>> pattern_chunks(chunk_results.size());
+    for (auto idx : combined) {
+        for (size_t chunk = 0; chunk < chunk_results.size(); chunk++) {
+            pattern_chunks[chunk] =
+                chunk_results[chunk].empty() ? std::vector<uintptr_t>{} : chunk_results[chunk][idx];
+        }
+        results[idx] = merge_chunk_matches(pattern_chunks, max_matches);
+    }
+
+    return results;
+}
+
+}  // namespace engine
+
+}  // namespace unrealsdk::memory
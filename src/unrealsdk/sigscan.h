@@ -0,0 +1,188 @@
+#ifndef UNREALSDK_SIGSCAN_H
+#define UNREALSDK_SIGSCAN_H
+
+// This file is deliberately independent of the rest of the sdk (and of windows), so that the
+// scanning code can be built and benchmarked on its own - see `tools/sigscan_bench`. Most code
+// should use the wrappers in `memory.h` instead.
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace unrealsdk::memory {
+
+/// The types of exe section a sigscan can search through.
+enum class SectionType : uint8_t {
+    /// Executable sections, e.g. `.text`.
+    CODE,
+    /// Non-executable sections holding initialized data, e.g. `.rdata` or `.data`.
+    DATA,
+    /// The entire exe, including it's headers and all other sections.
+    ANY,
+};
+
+/// A single section of a PE image.
+struct Section {
+    /// The section's name. Only null terminated if shorter than 8 characters.
+    std::array<char, 8> name;
+    /// The offset of the start of the section from the start of the image, once loaded.
+    uint32_t rva;
+    /// The length of the section, once loaded.
+    uint32_t size;
+    /// The section's characteristics flags.
+    uint32_t characteristics;
+
+    /**
+     * @brief Checks if this section should be searched for the given section type.
+     *
+     * @param type The section type to check.
+     * @return True if this section is of the given type.
+     */
+    [[nodiscard]] bool is_type(SectionType type) const;
+};
+
+/// A non-owning view over a sigscan pattern, used when scanning for several at once.
+struct PatternView {
+    /// The bytes to match.
+    const uint8_t* bytes;
+    /// A mask over the bytes to match. May be bit-level.
+    const uint8_t* mask;
+    /// The size of the bytes + mask.
+    size_t size;
+    /// The type of exe section to search through, when searching across the exe.
+    SectionType section = SectionType::CODE;
+};
+
+/// Passed as a max match count to find every match.
+const constexpr size_t ALL_MATCHES = std::numeric_limits<size_t>::max();
+
+/**
+ * @brief Parses the section table out of a PE image.
+ * @note Only reads the headers, so works on any buffer starting with them, not just loaded images.
+ *
+ * @param image A buffer holding the image.
+ * @return The image's sections, or an empty list if it's not a valid PE image.
+ */
+[[nodiscard]] std::vector<Section> parse_sections(std::span<const uint8_t> image);
+
+namespace engine {
+
+/// The different sigscan implementations, in increasing order of speed.
+enum class SigscanImpl : uint8_t {
+    SCALAR,
+    SSE2,
+    AVX2,
+};
+
+/// Regions smaller than this are always scanned on a single thread.
+const constexpr size_t MIN_PARALLEL_SIGSCAN_SIZE = 16ULL * 1024 * 1024;
+
+/**
+ * @brief Works out the fastest sigscan implementation the current cpu supports.
+ *
+ * @return The sigscan implementation.
+ */
+[[nodiscard]] SigscanImpl detect_sigscan_impl(void);
+
+/**
+ * @brief Gets the name of a sigscan implementation.
+ *
+ * @param impl The sigscan implementation.
+ * @return It's name.
+ */
+[[nodiscard]] std::string_view get_sigscan_impl_name(SigscanImpl impl);
+
+/**
+ * @brief Checks if a pattern matches at the given address.
+ *
+ * @param data The address to check. Must have at least the pattern's size bytes readable.
+ * @param pattern The pattern to check.
+ * @return True if the pattern matches.
+ */
+[[nodiscard]] bool matches_at(const uint8_t* data, const PatternView& pattern);
+
+/**
+ * @brief Performs a sigscan, using the given implementation.
+ * @note The pattern's section type is ignored.
+ *
+ * @param pattern The pattern to search for.
+ * @param start The address to start the search at.
+ * @param size The length of the region to search.
+ * @param impl The sigscan implementation to use. Must be supported by the current cpu.
+ * @param thread_count The max number of threads to split the scan across.
+ * @return The found location, or 0.
+ */
+[[nodiscard]] uintptr_t sigscan(const PatternView& pattern,
+                                uintptr_t start,
+                                size_t size,
+                                SigscanImpl impl,
+                                size_t thread_count);
+
+/**
+ * @brief Performs a sigscan for every match of a pattern, using the given implementation.
+ * @note Still a single pass over memory - the scan just continues past each match.
+ * @note The pattern's section type is ignored.
+ *
+ * @param pattern The pattern to search for.
+ * @param start The address to start the search at.
+ * @param size The length of the region to search.
+ * @param impl The sigscan implementation to use. Must be supported by the current cpu.
+ * @param thread_count The max number of threads to split the scan across.
+ * @param max_matches The max number of matches to find, after which the scan stops early.
+ * @return The found locations, in increasing order.
+ */
+[[nodiscard]] std::vector<uintptr_t> sigscan_all(const PatternView& pattern,
+                                                 uintptr_t start,
+                                                 size_t size,
+                                                 SigscanImpl impl,
+                                                 size_t thread_count,
+                                                 size_t max_matches = ALL_MATCHES);
+
+/**
+ * @brief Performs a sigscan for several patterns at once, using the given implementation.
+ * @note The patterns' section types are ignored.
+ *
+ * @param patterns The patterns to search for.
+ * @param start The address to start the search at.
+ * @param size The length of the region to search.
+ * @param impl The sigscan implementation to use. Must be supported by the current cpu.
+ * @param thread_count The max number of threads to split the scan across.
+ * @return The found location of each pattern (or 0), in the same order as given.
+ */
+[[nodiscard]] std::vector<uintptr_t> sigscan_many(std::span<const PatternView> patterns,
+                                                  uintptr_t start,
+                                                  size_t size,
+                                                  SigscanImpl impl,
+                                                  size_t thread_count);
+
+/**
+ * @brief Performs a sigscan for every match of several patterns at once, using the given
+ *        implementation.
+ * @note The patterns' section types are ignored.
+ *
+ * @param patterns The patterns to search for.
+ * @param start The address to start the search at.
+ * @param size The length of the region to search.
+ * @param impl The sigscan implementation to use. Must be supported by the current cpu.
+ * @param thread_count The max number of threads to split the scan across.
+ * @param max_matches The max number of matches to find of each pattern. The scan stops early once
+ *                    every pattern has been found this many times.
+ * @return The found locations of each pattern, in increasing order, in the same order as given.
+ */
+[[nodiscard]] std::vector<std::vector<uintptr_t>> sigscan_many_all(
+    std::span<const PatternView> patterns,
+    uintptr_t start,
+    size_t size,
+    SigscanImpl impl,
+    size_t thread_count,
+    size_t max_matches = ALL_MATCHES);
+
+}  // namespace engine
+
+}  // namespace unrealsdk::memory
+
+#endif /* UNREALSDK_SIGSCAN_H */
@@ -1,22 +1,187 @@
 #include "unrealsdk/pch.h"
 
+#include "unrealsdk/unreal/cast.h"
 #include "unrealsdk/unreal/classes/ufunction.h"
 #include "unrealsdk/unreal/classes/uproperty.h"
 #include "unrealsdk/unreal/offset_list.h"
 #include "unrealsdk/unreal/offsets.h"
+#include "unrealsdk/unreal/prop_traits.h"
+#include "unrealsdk/unreal/structs/fname.h"
+#include "unrealsdk/unreal/wrappers/wrapped_array.h"
+#include "unrealsdk/unreal/wrappers/wrapped_multicast_delegate.h"
+#include "unrealsdk/unreal/wrappers/wrapped_struct.h"
 #include "unrealsdk/unrealsdk.h"
 
 namespace unrealsdk::unreal {
 
 UNREALSDK_DEFINE_FIELDS_SOURCE_FILE(UFunction, UNREALSDK_UFUNCTION_FIELDS);
 
+namespace {
+
+/*
+Functions can get garbage collected, and a new one created at the same address. Since layouts hold
+raw property pointers, trusting a stale one would have us walking freed properties on every call.
+Blueprint functions commonly share names (e.g. `ExecuteUbergraph`), so the name alone isn't enough,
+we also compare the outer, the head of the property chain, and the params size. A new function
+would need to match all of these, at which point it's layout is the same anyway.
+*/
+struct LayoutKey {
+    FName name;
+    const UObject* outer;
+    const void* properties;
+    uint16_t params_size;
+
+    bool operator==(const LayoutKey& other) const = default;
+};
+
+struct CachedLayout {
+    LayoutKey key;
+    std::unique_ptr<const FunctionLayout> layout;
+};
+
+/*
+There's one entry per address a function has lived at. When we find a different function at an
+address, it's old layout gets freed and replaced - anyone still using it would also be using the old
+function, which is already gone. This means the cache never holds more layouts than there have been
+distinct function addresses.
+*/
+std::shared_mutex layouts_mutex{};
+std::unordered_map<const UFunction*, CachedLayout> layouts{};
+
+// Incremented whenever a layout is freed, so that the thread caches know to stop trusting theirs
+std::atomic<uint64_t> layouts_generation = 0;
+
+// Small per-thread cache in front of the main one, so that the common case doesn't need a lock
+const constexpr size_t THREAD_CACHE_SIZE = 0x40;
+struct ThreadCacheEntry {
+    const UFunction* func;
+    uint64_t generation;
+    LayoutKey key;
+    const FunctionLayout* layout;
+};
+thread_local std::array<ThreadCacheEntry, THREAD_CACHE_SIZE> thread_cache{};
+
+/**
+ * @brief Gets the key used to check if a cached layout still belongs to the given function.
+ *
+ * @param func The function to get the key of.
+ * @return The layout key.
+ */
+LayoutKey get_layout_key(const UFunction* func) {
+    return {
+        .name = func->Name(),
+        .outer = func->Outer(),
+#if UNREALSDK_PROPERTIES_ARE_FFIELD
+        .properties = func->ChildProperties(),
+#else
+        .properties = func->PropertyLink(),
+#endif
+        .params_size = func->ParamsSize(),
+    };
+}
+
+/**
+ * @brief Calculates the layout of a function's params.
+ *
+ * @param func The function to calculate the layout of.
+ * @return The layout.
+ */
+std::unique_ptr<const FunctionLayout> calculate_layout(const UFunction* func) {
+    auto layout = std::make_unique<FunctionLayout>(FunctionLayout{
+        .return_param = nullptr,
+        .params = {},
+        .required_params = 0,
+        .size = func->ParamsSize(),
+        .has_reference_params = false,
+    });
+
+    for (auto prop : func->properties()) {
+        auto flags = prop->PropertyFlags();
+        if ((flags & UProperty::PROP_FLAG_PARAM) == 0) {
+            continue;
+        }
+
+        cast(prop, [&layout]<typename T>(const T* /* prop */) {
+            using value_type = typename PropTraits<T>::Value;
+            if constexpr (std::is_same_v<value_type, WrappedStruct>
+                          || std::is_same_v<value_type, WrappedArray>
+                          || std::is_same_v<value_type, WrappedMulticastDelegate>) {
+                layout->has_reference_params = true;
+            }
+        });
+
+        if ((flags & UProperty::PROP_FLAG_RETURN) != 0) {
+            layout->return_param = prop;
+            continue;
+        }
+
+#if UNREALSDK_HAS_OPTIONAL_FUNC_PARAMS
+        const bool is_optional = (flags & UProperty::PROP_FLAG_OPTIONAL) != 0;
+#else
+        const bool is_optional = false;
+#endif
+
+        layout->params.push_back({
+            .prop = prop,
+            .offset = static_cast<size_t>(prop->Offset_Internal()),
+            .is_optional = is_optional,
+            .is_out = (flags & UProperty::PROP_FLAG_OUT) != 0,
+        });
+        if (!is_optional) {
+            layout->required_params = layout->params.size();
+        }
+    }
+
+    return layout;
+}
+
+}  // namespace
+
 UProperty* UFunction::find_return_param(void) const {
-    for (auto prop : this->properties()) {
-        if ((prop->PropertyFlags() & UProperty::PROP_FLAG_RETURN) != 0) {
-            return prop;
+    return this->layout().return_param;
+}
+
+const FunctionLayout& UFunction::layout(void) const {
+    auto key = get_layout_key(this);
+    auto generation = layouts_generation.load(std::memory_order_acquire);
+
+    auto& thread_entry =
+        thread_cache[(reinterpret_cast<uintptr_t>(this) / alignof(UFunction)) % THREAD_CACHE_SIZE];
+    if (thread_entry.func == this && thread_entry.generation == generation
+        && thread_entry.key == key) {
+        return *thread_entry.layout;
+    }
+
+    const FunctionLayout* layout = nullptr;
+    {
+        const std::shared_lock lock(layouts_mutex);
+        auto iter = layouts.find(this);
+        if (iter != layouts.end() && iter->second.key == key) {
+            layout = iter->second.layout.get();
+        }
+        // Grab the generation under the lock, so that it can't include a layout we haven't seen
+        generation = layouts_generation.load(std::memory_order_relaxed);
+    }
+
+    if (layout == nullptr) {
+        // Calculate outside of the lock, we might end up doing it twice, but that's harmless
+        auto new_layout = calculate_layout(this);
+
+        const std::unique_lock lock(layouts_mutex);
+        auto& cached = layouts[this];
+        if (cached.layout == nullptr || cached.key != key) {
+            if (cached.layout != nullptr) {
+                // This address used to hold a different function, free it's stale layout
+                layouts_generation.fetch_add(1, std::memory_order_relaxed);
+            }
+            cached = {.key = key, .layout = std::move(new_layout)};
         }
+        layout = cached.layout.get();
+        generation = layouts_generation.load(std::memory_order_relaxed);
     }
-    return nullptr;
+
+    thread_entry = {.func = this, .generation = generation, .key = key, .layout = layout};
+    return *layout;
 }
 
 }  // namespace unrealsdk::unreal
@@ -7,6 +7,31 @@
 
 namespace unrealsdk::unreal {
 
+struct FunctionParam {
+    /// The param's property, which also gives it's type.
+    UProperty* prop;
+    /// The offset of the param within the params struct.
+    size_t offset;
+    /// If the param is optional.
+    bool is_optional;
+    /// If the param is an out param.
+    bool is_out;
+};
+
+struct FunctionLayout {
+    /// The return param, or nullptr if the function doesn't return anything.
+    UProperty* return_param;
+    /// All other params, in order.
+    std::vector<FunctionParam> params;
+    /// The minimum number of params which need to be given to call the function.
+    size_t required_params;
+    /// The total size of the params struct.
+    size_t size;
+    /// If any params are of a type which gets returned as a reference into the params struct -
+    /// i.e. structs, arrays, or multicast delegates.
+    bool has_reference_params;
+};
+
 class UFunction : public UStruct {
    public:
     static constexpr auto FUNC_NATIVE = 0x400;
@@ -34,6 +59,14 @@ class UFunction : public UStruct {
      * @return The return param, or `nullptr` if none exists.
      */
     [[nodiscard]] UProperty* find_return_param(void) const;
+
+    /**
+     * @brief Gets the layout of this function's params.
+     * @note Calculated the first time it's requested, and cached afterwards.
+     *
+     * @return The params layout. Valid for as long as this function is.
+     */
+    [[nodiscard]] const FunctionLayout& layout(void) const;
 };
 
 template <>
@@ -10,36 +10,6 @@
 
 namespace unrealsdk::unreal {
 
-namespace func_params::impl {
-
-UProperty* get_next_param(UProperty* prop) {
-    prop = prop->PropertyLinkNext();
-    while (prop != nullptr && (prop->PropertyFlags() & UProperty::PROP_FLAG_PARAM) == 0) {
-        prop = prop->PropertyLinkNext();
-    }
-    return prop;
-}
-
-void validate_no_more_params(UProperty* prop) {
-    for (; prop != nullptr; prop = prop->PropertyLinkNext()) {
-        if ((prop->PropertyFlags() & UProperty::PROP_FLAG_PARAM) == 0) {
-            continue;
-        }
-        if ((prop->PropertyFlags() & UProperty::PROP_FLAG_RETURN) != 0) {
-            continue;
-        }
-#if UNREALSDK_HAS_OPTIONAL_FUNC_PARAMS
-        if ((prop->PropertyFlags() & UProperty::PROP_FLAG_OPTIONAL) != 0) {
-            continue;
-        }
-#endif
-
-        throw std::runtime_error("Too few parameters to function call!");
-    }
-}
-
-}  // namespace func_params::impl
-
 UNREALSDK_CAPI(void, bound_function_call_with_params, const BoundFunction* self, void* params);
 
 #ifndef UNREALSDK_IMPORTING
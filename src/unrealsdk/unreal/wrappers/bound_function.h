@@ -19,52 +19,23 @@ namespace func_params {
 namespace impl {
 
 /**
- * @brief Get the next parameter property in the chain.
- * @note Includes optional properties.
+ * @brief Sets a single arg in a function's params struct.
  *
- * @param prop The current property to start at.
- * @return The next parameter, or nullptr on reaching the end of the chain.
+ * @tparam T The type of the arg.
+ * @param params The params struct to write to.
+ * @param param The param to set.
+ * @param value The arg's value.
  */
-[[nodiscard]] UProperty* get_next_param(UProperty* prop);
-
-/**
- * @brief Checks that there are no more required params for a function call.
- *
- * @param prop The next unparsed parameter property object.
- */
-void validate_no_more_params(UProperty* prop);
-
-/**
- * @brief Tail recursive function to set all args in a function's params struct.
- *
- * @tparam T0 The type of the first arg, which this call will set.
- * @tparam Ts The types of the remaining args.
- * @param params A pointer to the params struct.
- * @param prop The next unparsed parameter property object.
- * @param arg0 This argument.
- * @param args The remaining arguments.
- */
-template <typename T0, typename... Ts>
+template <typename T>
 void set_param(WrappedStruct& params,
-               UProperty* prop,
-               const typename PropTraits<T0>::Value& arg0,
-               const typename PropTraits<Ts>::Value&... args) {
-    if (prop == nullptr) {
-        throw std::runtime_error("Too many parameters to function call!");
-    }
-    if (prop->ArrayDim() > 1) {
+               const FunctionParam& param,
+               const typename PropTraits<T>::Value& value) {
+    if (param.prop->ArrayDim() > 1) {
         throw std::runtime_error(
             "Function has static array argument - unsure how to handle, aborting!");
     }
 
-    params.set<T0>(validate_type<T0>(prop), 0, arg0);
-
-    auto next = get_next_param(prop);
-    if constexpr (sizeof...(Ts) > 0) {
-        set_param<Ts...>(params, next, args...);
-    } else {
-        validate_no_more_params(next);
-    }
+    params.set<T>(validate_type<T>(param.prop), 0, value);
 }
 
 }  // namespace impl
@@ -78,16 +49,19 @@ void set_param(WrappedStruct& params,
  */
 template <typename... Ts>
 void write_params(WrappedStruct& params, const typename PropTraits<Ts>::Value&... args) {
-    UProperty* prop = params.type->PropertyLink();
-    if (prop != nullptr && (prop->PropertyFlags() & UProperty::PROP_FLAG_PARAM) == 0) {
-        prop = impl::get_next_param(prop);
-    }
+    // Params structs are always of function types
+    const auto& layout = static_cast<const UFunction*>(params.type)->layout();
 
-    if constexpr (sizeof...(Ts) > 0) {
-        impl::set_param<Ts...>(params, prop, args...);
-    } else {
-        impl::validate_no_more_params(prop);
+    if (sizeof...(Ts) > layout.params.size()) {
+        throw std::runtime_error("Too many parameters to function call!");
     }
+    if (sizeof...(Ts) < layout.required_params) {
+        throw std::runtime_error("Too few parameters to function call!");
+    }
+
+    [&]<size_t... Is>(std::index_sequence<Is...>) {
+        (impl::set_param<Ts>(params, layout.params[Is], args), ...);
+    }(std::index_sequence_for<Ts...>{});
 }
 
 /**
@@ -108,7 +82,7 @@ using return_type = std::conditional_t<std::is_void_v<R>, void, typename PropTra
 template <typename R>
 return_type<R> get_return_value(const UFunction* func, const WrappedStruct& params) {
     if constexpr (!std::is_void_v<R>) {
-        auto ret = func->find_return_param();
+        auto ret = func->layout().return_param;
         if (ret == nullptr) {
             throw std::runtime_error("Couldn't find return param!");
         }
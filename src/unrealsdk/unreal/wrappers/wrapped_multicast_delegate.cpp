@@ -45,10 +45,12 @@ void WrappedMulticastDelegate::call(WrappedStruct& params) const {
     }
 
     // For the first N-1 entries, copy the params struct each time, in case the call edits it
+    // Only the params get passed along, so only copy those, which goes through the signature's
+    // cached layout rather than walking every property
     for (size_t i = 0; i < this->base->size() - 1; i++) {
         auto func = this->base->data[i].as_function();
 
-        WrappedStruct params_copy = params;
+        WrappedStruct params_copy = params.copy_params_only();
 
         // Since the function is a different type to the signature, to do the call we need to swap
         // the type of the params with that of the exact function we're calling.
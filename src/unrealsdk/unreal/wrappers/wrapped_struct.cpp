@@ -1,8 +1,10 @@
 #include "unrealsdk/pch.h"
 #include "unrealsdk/unreal/wrappers/wrapped_struct.h"
 #include "unrealsdk/unreal/cast.h"
+#include "unrealsdk/unreal/classes/ufunction.h"
 #include "unrealsdk/unreal/classes/uproperty.h"
 #include "unrealsdk/unreal/classes/ustruct.h"
+#include "unrealsdk/unreal/find_class.h"
 #include "unrealsdk/unreal/prop_traits.h"
 #include "unrealsdk/unreal/wrappers/unreal_pointer.h"
 #include "unrealsdk/unreal/wrappers/unreal_pointer_funcs.h"
@@ -10,6 +12,44 @@
 
 namespace unrealsdk::unreal {
 
+namespace {
+
+/**
+ * @brief Copies all properties marked as parameters on a struct.
+ *
+ * @param dest The address of the struct to copy to.
+ * @param src The source struct to copy from.
+ */
+void copy_params(uintptr_t dest, const WrappedStruct& src) {
+    auto copy_prop = [dest, &src](UProperty* prop) {
+        cast(prop, [dest, &src]<typename T>(const T* prop) {
+            for (size_t i = 0; i < (size_t)prop->ArrayDim(); i++) {
+                set_property<T>(prop, i, dest, src.get<T>(prop, i));
+            }
+        });
+    };
+
+    // Functions have their params cached, so we don't need to walk the whole property chain
+    if (src.type->is_instance(find_class<UFunction>())) {
+        const auto& layout = static_cast<const UFunction*>(src.type)->layout();
+        for (const auto& param : layout.params) {
+            copy_prop(param.prop);
+        }
+        if (layout.return_param != nullptr) {
+            copy_prop(layout.return_param);
+        }
+        return;
+    }
+
+    for (const auto& prop : src.type->properties()) {
+        if ((prop->PropertyFlags() & UProperty::PROP_FLAG_PARAM) != 0) {
+            copy_prop(prop);
+        }
+    }
+}
+
+}  // namespace
+
 void copy_struct(uintptr_t dest, const WrappedStruct& src) {
     if (dest == reinterpret_cast<uintptr_t>(src.base.get())) {
         LOG(DEV_WARNING, "Refusing to copy struct of type {} to itself, at address {:p}",
@@ -17,6 +57,12 @@ void copy_struct(uintptr_t dest, const WrappedStruct& src) {
         return;
     }
 
+    // A view only covers the params, anything after them may not even be valid memory
+    if (src.copy_on_write) {
+        copy_params(dest, src);
+        return;
+    }
+
     for (const auto& prop : src.type->properties()) {
         cast(prop, [dest, &src]<typename T>(const T* prop) {
             for (size_t i = 0; i < (size_t)prop->ArrayDim(); i++) {
@@ -56,12 +102,18 @@ WrappedStruct::WrappedStruct(const WrappedStruct& other) : type(other.type), bas
 }
 
 WrappedStruct::WrappedStruct(WrappedStruct&& other) noexcept
-    : type(std::exchange(other.type, nullptr)), base(std::exchange(other.base, {nullptr})) {}
+    : type(std::exchange(other.type, nullptr)),
+      base(std::exchange(other.base, {nullptr})),
+      copy_on_write(std::exchange(other.copy_on_write, false)) {}
+
+WrappedStruct::WrappedStruct(CopyOnWriteTag /* tag */, const WrappedStruct& src)
+    : type(src.type), base(src.base, src.base.get()), copy_on_write(true) {}
 
 WrappedStruct& WrappedStruct::operator=(const WrappedStruct& other) {
     if (other.type != this->type) {
         throw std::runtime_error("Struct is not an instance of " + (std::string)this->type->Name());
     }
+    this->materialize();
     if (this->base != nullptr && other.base != nullptr) {
         copy_struct(reinterpret_cast<uintptr_t>(this->base.get()), other);
     }
@@ -70,6 +122,7 @@ WrappedStruct& WrappedStruct::operator=(const WrappedStruct& other) {
 WrappedStruct& WrappedStruct::operator=(WrappedStruct&& other) noexcept {
     std::swap(this->type, other.type);
     std::swap(this->base, other.base);
+    std::swap(this->copy_on_write, other.copy_on_write);
     return *this;
 }
 
@@ -79,20 +132,37 @@ WrappedStruct WrappedStruct::copy_params_only(void) const {
         return new_struct;
     }
 
-    auto dest = reinterpret_cast<uintptr_t>(new_struct.base.get());
-    for (const auto& prop : this->type->properties()) {
-        if ((prop->PropertyFlags() & UProperty::PROP_FLAG_PARAM) == 0) {
-            continue;
-        }
+    copy_params(reinterpret_cast<uintptr_t>(new_struct.base.get()), *this);
+    return new_struct;
+}
 
-        cast(prop, [dest, this]<typename T>(const T* prop) {
-            for (size_t i = 0; i < (size_t)prop->ArrayDim(); i++) {
-                set_property<T>(prop, i, dest, this->get<T>(prop, i));
-            }
-        });
+WrappedStruct WrappedStruct::copy_params_on_write(void) const {
+    if (this->base == nullptr) {
+        return this->copy_params_only();
     }
 
-    return new_struct;
+    // We rely on the function's layout below, anything else just gets an eager copy
+    if (!this->type->is_instance(find_class<UFunction>())) {
+        return this->copy_params_only();
+    }
+
+    // Structs, arrays, and delegates all get returned as references into their parent - if a hook
+    // grabbed one, and held onto it past the end of the call, it'd be left dangling
+    if (static_cast<const UFunction*>(this->type)->layout().has_reference_params) {
+        return this->copy_params_only();
+    }
+
+    return {CopyOnWriteTag{}, *this};
+}
+
+void WrappedStruct::materialize(void) {
+    if (!this->copy_on_write) {
+        return;
+    }
+
+    auto new_struct = this->copy_params_only();
+    this->base = std::move(new_struct.base);
+    this->copy_on_write = false;
 }
 
 }  // namespace unrealsdk::unreal
@@ -91,6 +91,7 @@ class WrappedStruct {
     }
     template <typename T>
     void set(const T* prop, size_t idx, const typename PropTraits<T>::Value& value) {
+        this->materialize();
         set_property<T>(prop, idx, reinterpret_cast<uintptr_t>(this->base.get()), value);
     }
 
@@ -102,6 +103,38 @@ class WrappedStruct {
      * @return A new wrapped struct.
      */
     [[nodiscard]] WrappedStruct copy_params_only(void) const;
+
+    /**
+     * @brief Creates a copy-on-write view of this struct's parameters.
+     * @note The view reads straight from this struct, and only makes a copy (as if by
+     *       `copy_params_only`) the first time it's written to. Moving the view moves the view
+     *       itself, it does not make a copy. The view must not outlive this struct, unless
+     *       `materialize` was called.
+     * @note This struct's type must be a function.
+     * @note Since sub-structs, arrays, and delegates are all references into their parent, if any
+     *       parameters are of these types, returns an eager copy instead.
+     * @note Only properties marked as parameters may be accessed through the view.
+     * @note Anything writing through `base` directly must call `materialize` first.
+     * @note Only really useful in the context of our internal pre-hook processing.
+     *
+     * @return A new wrapped struct.
+     */
+    [[nodiscard]] WrappedStruct copy_params_on_write(void) const;
+
+    /**
+     * @brief If this is a copy-on-write view, copies it's parameters, so that it owns it's memory.
+     * @note No-op if this isn't a view.
+     */
+    void materialize(void);
+
+   private:
+    // If set, base points at memory owned by someone else, which we must copy before writing to
+    bool copy_on_write = false;
+
+    struct CopyOnWriteTag {};
+    WrappedStruct(CopyOnWriteTag /* tag */, const WrappedStruct& src);
+
+    friend void copy_struct(uintptr_t dest, const WrappedStruct& src);
 };
 
 /**
@@ -4,6 +4,7 @@
 #include "unrealsdk/game/abstract_hook.h"
 #include "unrealsdk/hook_manager.h"
 #include "unrealsdk/logging.h"
+#include "unrealsdk/profiler.h"
 #include "unrealsdk/unreal/find_class.h"
 #include "unrealsdk/unrealsdk.h"
 #include "unrealsdk/version.h"
@@ -51,25 +52,34 @@ bool init(const std::function<std::unique_ptr<game::AbstractHook>(void)>& game_g
         return false;
     }
 
-    config::load();
-    logging::init(utils::get_this_dll().parent_path()
-                  / config::get_str("unrealsdk.log_file").value_or("unrealsdk.log"));
+    {
+        const profiler::impl::ScopedStartupPhase init_phase{"init"};
 
-    auto version = unrealsdk::get_version_string();
-    LOG(INFO, "{}", version);
-    LOG(INFO, "{}", std::string(version.size(), '='));
+        config::load();
+        logging::init(utils::get_this_dll().parent_path()
+                      / config::get_str("unrealsdk.log_file").value_or("unrealsdk.log"));
 
-    if (MH_Initialize() != MH_OK) {
-        throw std::runtime_error("Minhook initialization failed!");
-    }
+        auto version = unrealsdk::get_version_string();
+        LOG(INFO, "{}", version);
+        LOG(INFO, "{}", std::string(version.size(), '='));
+
+        if (MH_Initialize() != MH_OK) {
+            throw std::runtime_error("Minhook initialization failed!");
+        }
+
+        auto game = game_getter();
 
-    auto game = game_getter();
+        // Initialize the hook before moving it, to weed out any unexpected calls to the globals.
+        profiler::impl::time_startup_phase("hook", [&game]() { game->hook(); });
+        hook_instance = std::move(game);
 
-    // Initialize the hook before moving it, to weed out any unexpected calls to the globals.
-    game->hook();
-    hook_instance = std::move(game);
+        profiler::impl::time_startup_phase("post_init", []() { hook_instance->post_init(); });
+
+        hook_manager::impl::register_commands();
+        profiler::impl::register_commands();
+    }
 
-    hook_instance->post_init();
+    profiler::impl::log_startup_phases();
 
     return true;
 }
@@ -0,0 +1,227 @@
+#!/usr/bin/env python3
+"""
+Converts a binary call trace, as written by `unrealsdk::hook_manager::log_all_calls`, into a tsv.
+
+File format
+-----------
+All values are little endian. Strings are a u32 character count, followed by that many characters
+of `char_size` bytes each - i.e. UTF-16 on Windows.
+
+The file starts with a header:
+    char[8]  magic        "USDKCALL"
+    u32      version      1
+    u16      record_size  The size of a single call record, 40
+    u16      char_size    The size of a single string character
+    u64      frequency    The number of timestamp ticks per second
+
+This is followed by a stream of blocks, each starting with a u8 block type.
+
+Type 1, Source - names one of the sources calls can come from.
+    u8       id
+    string   name
+
+Type 2, Name - gives the full path name of an object.
+    u64      pointer      The address of the object.
+    i32      name_index   The index of the object's fname, to differentiate reused addresses.
+    string   name
+
+Type 3, Calls - a batch of calls.
+    u32      count
+    Followed by `count` records:
+    u64      timestamp
+    u64      func         The address of the function which was called.
+    u64      obj          The address of the object it was called on.
+    u32      thread_id
+    i32      func_name    The index of the function's fname.
+    i32      obj_name     The index of the object's fname.
+    u8       source       The id of the source of the call.
+    u8[3]    padding
+
+Calls may be written before the name or source blocks they refer to, so the whole file needs to be
+read before resolving them. If the same object appears in multiple name blocks (which happens if
+it was seen on multiple threads), the names are identical.
+"""
+
+import argparse
+import struct
+import sys
+from collections.abc import Iterator
+from pathlib import Path
+from typing import BinaryIO, NamedTuple, TextIO
+
+MAGIC = b"USDKCALL"
+VERSION = 1
+
+HEADER = struct.Struct("<8sIHHQ")
+BLOCK_TYPE = struct.Struct("<B")
+U8 = struct.Struct("<B")
+U32 = struct.Struct("<I")
+NAME_HEADER = struct.Struct("<Qi")
+RECORD = struct.Struct("<QQQIiiB3x")
+
+BLOCK_SOURCE = 1
+BLOCK_NAME = 2
+BLOCK_CALLS = 3
+
+
+class Call(NamedTuple):
+    timestamp: int
+    func: int
+    obj: int
+    thread_id: int
+    func_name: int
+    obj_name: int
+    source: int
+
+
+class Trace(NamedTuple):
+    frequency: int
+    sources: dict[int, str]
+    names: dict[tuple[int, int], str]
+    calls: list[Call]
+
+
+def read_exact(file: BinaryIO, size: int) -> bytes:
+    """
+    Reads an exact number of bytes from a file.
+
+    Args:
+        file: The file to read from.
+        size: How many bytes to read.
+    Returns:
+        The read bytes.
+    """
+    data = file.read(size)
+    if len(data) != size:
+        raise EOFError("Trace file ended unexpectedly")
+    return data
+
+
+def read_string(file: BinaryIO, char_size: int) -> str:
+    """
+    Reads a length-prefixed string from a file.
+
+    Args:
+        file: The file to read from.
+        char_size: The size of a single character.
+    Returns:
+        The read string.
+    """
+    (length,) = U32.unpack(read_exact(file, U32.size))
+    encoding = {2: "utf-16-le", 4: "utf-32-le"}[char_size]
+    return read_exact(file, length * char_size).decode(encoding, errors="replace")
+
+
+def read_trace(file: BinaryIO) -> Trace:
+    """
+    Reads an entire trace file.
+
+    Args:
+        file: The file to read from.
+    Returns:
+        The parsed trace.
+    """
+    magic, version, record_size, char_size, frequency = HEADER.unpack(
+        read_exact(file, HEADER.size),
+    )
+    if magic != MAGIC:
+        raise ValueError("File is not a call trace")
+    if version != VERSION:
+        raise ValueError(f"Unsupported call trace version {version}")
+    if record_size != RECORD.size:
+        raise ValueError(f"Unexpected call record size {record_size}")
+
+    trace = Trace(frequency, {}, {}, [])
+
+    while block_type_data := file.read(BLOCK_TYPE.size):
+        (block_type,) = BLOCK_TYPE.unpack(block_type_data)
+        if block_type == BLOCK_SOURCE:
+            (source_id,) = U8.unpack(read_exact(file, U8.size))
+            trace.sources[source_id] = read_string(file, char_size)
+        elif block_type == BLOCK_NAME:
+            pointer, name_index = NAME_HEADER.unpack(read_exact(file, NAME_HEADER.size))
+            trace.names[(pointer, name_index)] = read_string(file, char_size)
+        elif block_type == BLOCK_CALLS:
+            (count,) = U32.unpack(read_exact(file, U32.size))
+            data = read_exact(file, count * RECORD.size)
+            trace.calls.extend(Call(*record) for record in RECORD.iter_unpack(data))
+        else:
+            raise ValueError(f"Unknown block type {block_type}")
+
+    return trace
+
+
+def iter_rows(trace: Trace, timing: bool) -> Iterator[list[str]]:
+    """
+    Iterates through the rows of the output tsv.
+
+    Args:
+        trace: The trace to convert.
+        timing: If to include timing and thread columns.
+    Yields:
+        Each row's columns.
+    """
+
+    def get_name(pointer: int, name_index: int) -> str:
+        return trace.names.get((pointer, name_index), f"<unknown 0x{pointer:X}>")
+
+    # Calls are batched per thread, sort them back into the order they happened
+    calls = sorted(trace.calls, key=lambda call: call.timestamp)
+    start = calls[0].timestamp if calls else 0
+
+    for call in calls:
+        row = [
+            trace.sources.get(call.source, f"<unknown {call.source}>"),
+            get_name(call.func, call.func_name),
+            get_name(call.obj, call.obj_name),
+        ]
+        if timing:
+            micros = (call.timestamp - start) * 1_000_000 // trace.frequency
+            row = [str(micros), str(call.thread_id), *row]
+        yield row
+
+
+def write_tsv(trace: Trace, output: TextIO, timing: bool) -> None:
+    """
+    Writes a trace out as a tsv.
+
+    Args:
+        trace: The trace to convert.
+        output: The stream to write to.
+        timing: If to include timing and thread columns.
+    """
+    for row in iter_rows(trace, timing):
+        output.write("\t".join(row) + "\n")
+
+
+def main() -> None:  # noqa: D103
+    parser = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+    parser.add_argument("trace", type=Path, help="The binary trace file to convert.")
+    parser.add_argument(
+        "output",
+        type=Path,
+        nargs="?",
+        help="The tsv file to write. Defaults to stdout.",
+    )
+    parser.add_argument(
+        "--timing",
+        action="store_true",
+        help=(
+            "Add leading columns with the time since the first call (in microseconds) and the"
+            " thread id."
+        ),
+    )
+    args = parser.parse_args()
+
+    with args.trace.open("rb") as file:
+        trace = read_trace(file)
+
+    if args.output is None:
+        write_tsv(trace, sys.stdout, args.timing)
+    else:
+        with args.output.open("w", encoding="utf8", newline="\n") as output:
+            write_tsv(trace, output, args.timing)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,259 @@
+/*
+Checks `parse_sections` and `Section::is_type` against synthetic PE headers.
+
+This builds alongside the benchmark, on any platform, without the rest of the sdk:
+
+    cmake -S tools/sigscan_bench -B build-bench
+    cmake --build build-bench
+    ctest --test-dir build-bench
+
+Each case builds a minimal image by hand - just a DOS header pointing at the PE signature, a file
+header, an (empty) optional header, and the section table - then checks what gets parsed out of it.
+Exits with a non-zero code if any check fails.
+*/
+
+#include "unrealsdk/sigscan.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <source_location>
+#include <string_view>
+#include <vector>
+
+using namespace unrealsdk::memory;
+
+namespace {
+
+const constexpr size_t E_LFANEW_OFFSET = 0x3C;
+const constexpr size_t PE_HEADER_OFFSET = 0x80;
+const constexpr size_t FILE_HEADER_SIZE = 20;
+const constexpr size_t OPTIONAL_HEADER_SIZE = 0xF0;
+const constexpr size_t SECTION_HEADER_SIZE = 40;
+
+const constexpr uint32_t CNT_CODE = 0x00000020;
+const constexpr uint32_t CNT_INITIALIZED_DATA = 0x00000040;
+const constexpr uint32_t CNT_UNINITIALIZED_DATA = 0x00000080;
+const constexpr uint32_t MEM_EXECUTE = 0x20000000;
+const constexpr uint32_t MEM_READ = 0x40000000;
+const constexpr uint32_t MEM_WRITE = 0x80000000;
+
+struct SyntheticSection {
+    std::string_view name;
+    uint32_t virtual_size;
+    uint32_t rva;
+    uint32_t raw_size;
+    uint32_t characteristics;
+};
+
+size_t failures = 0;
+
+/**
+ * @brief Records the result of a single check.
+ *
+ * @param passed True if the check passed.
+ * @param what A description of what was being checked.
+ * @param location The location of the check.
+ */
+void check(bool passed,
+           const char* what,
+           std::source_location location = std::source_location::current()) {
+    if (!passed) {
+        failures++;
+        std::fprintf(stderr, "FAILED (line %u): %s\n", static_cast<unsigned>(location.line()),
+                     what);
+    }
+}
+
+/**
+ * @brief Writes a little endian integer into a buffer.
+ *
+ * @tparam T The type of integer to write.
+ * @param buffer The buffer to write to.
+ * @param offset The offset to write at.
+ * @param value The value to write.
+ */
+template <typename T>
+void write_le(std::vector<uint8_t>& buffer, size_t offset, T value) {
+    for (size_t i = 0; i < sizeof(T); i++) {
+        buffer[offset + i] = static_cast<uint8_t>(value >> (i * 8));
+    }
+}
+
+/**
+ * @brief Builds the headers of a PE image.
+ *
+ * @param sections The sections to put in the section table.
+ * @return A buffer holding the headers, ending right after the section table.
+ */
+std::vector<uint8_t> make_image(const std::vector<SyntheticSection>& sections) {
+    auto section_table = PE_HEADER_OFFSET + 4 + FILE_HEADER_SIZE + OPTIONAL_HEADER_SIZE;
+    std::vector<uint8_t> image(section_table + (sections.size() * SECTION_HEADER_SIZE));
+
+    image[0] = 'M';
+    image[1] = 'Z';
+    write_le<uint32_t>(image, E_LFANEW_OFFSET, PE_HEADER_OFFSET);
+
+    image[PE_HEADER_OFFSET] = 'P';
+    image[PE_HEADER_OFFSET + 1] = 'E';
+    auto file_header = PE_HEADER_OFFSET + 4;
+    write_le<uint16_t>(image, file_header + 2, static_cast<uint16_t>(sections.size()));
+    write_le<uint16_t>(image, file_header + 16, OPTIONAL_HEADER_SIZE);
+
+    for (size_t i = 0; i < sections.size(); i++) {
+        const auto& section = sections[i];
+        auto header = section_table + (i * SECTION_HEADER_SIZE);
+        std::ranges::copy(section.name.substr(0, 8),
+                          image.begin() + static_cast<ptrdiff_t>(header));
+        write_le<uint32_t>(image, header + 8, section.virtual_size);
+        write_le<uint32_t>(image, header + 12, section.rva);
+        write_le<uint32_t>(image, header + 16, section.raw_size);
+        write_le<uint32_t>(image, header + 36, section.characteristics);
+    }
+
+    return image;
+}
+
+/**
+ * @brief Gets a section's name as a string view.
+ *
+ * @param section The section.
+ * @return The section's name.
+ */
+std::string_view name_of(const Section& section) {
+    std::string_view name{section.name.data(), section.name.size()};
+    return name.substr(0, name.find('\0'));
+}
+
+const std::vector<SyntheticSection> TYPICAL_SECTIONS = {
+    {".text", 0x5000, 0x1000, 0x5000, CNT_CODE | MEM_EXECUTE | MEM_READ},
+    {".rdata", 0x2000, 0x6000, 0x2000, CNT_INITIALIZED_DATA | MEM_READ},
+    {".data", 0x3000, 0x8000, 0x1000, CNT_INITIALIZED_DATA | MEM_READ | MEM_WRITE},
+    {".bss", 0x1000, 0xB000, 0, CNT_UNINITIALIZED_DATA | MEM_READ | MEM_WRITE},
+    {".reloc8ch", 0x200, 0xC000, 0x200, CNT_INITIALIZED_DATA | MEM_READ},
+};
+
+void check_typical_image(void) {
+    auto sections = parse_sections(make_image(TYPICAL_SECTIONS));
+    check(sections.size() == TYPICAL_SECTIONS.size(), "parses every section");
+    if (sections.size() != TYPICAL_SECTIONS.size()) {
+        return;
+    }
+
+    check(name_of(sections[0]) == ".text", "reads short names up to the null");
+    check(name_of(sections[4]) == ".reloc8c", "truncates 8 character names without a null");
+    check(sections[1].rva == 0x6000, "reads the rva");
+    check(sections[2].size == 0x3000, "prefers the virtual size over the raw size");
+
+    check(sections[0].is_type(SectionType::CODE), ".text is code");
+    check(!sections[0].is_type(SectionType::DATA), ".text is not data");
+    check(!sections[1].is_type(SectionType::CODE), ".rdata is not code");
+    check(sections[1].is_type(SectionType::DATA), ".rdata is data");
+    check(sections[2].is_type(SectionType::DATA), ".data is data");
+    check(!sections[3].is_type(SectionType::CODE), ".bss is not code");
+    check(!sections[3].is_type(SectionType::DATA), ".bss is not initialized data");
+    for (const auto& section : sections) {
+        check(section.is_type(SectionType::ANY), "every section matches any");
+    }
+}
+
+void check_unusual_flags(void) {
+    auto sections = parse_sections(make_image({
+        {"code", 0x100, 0x1000, 0x100, CNT_CODE},
+        {"exec", 0x100, 0x2000, 0x100, MEM_EXECUTE},
+        {"mixed", 0x100, 0x3000, 0x100, CNT_INITIALIZED_DATA | MEM_EXECUTE},
+        {"none", 0x100, 0x4000, 0x100, 0},
+    }));
+    check(sections.size() == 4, "parses sections with unusual flags");
+    if (sections.size() != 4) {
+        return;
+    }
+
+    check(sections[0].is_type(SectionType::CODE), "contains code without execute is code");
+    check(sections[1].is_type(SectionType::CODE), "execute without contains code is code");
+    check(sections[2].is_type(SectionType::CODE), "executable initialized data is code");
+    check(!sections[2].is_type(SectionType::DATA), "executable initialized data is not data");
+    check(!sections[3].is_type(SectionType::CODE), "a section without flags is not code");
+    check(!sections[3].is_type(SectionType::DATA), "a section without flags is not data");
+    check(sections[3].is_type(SectionType::ANY), "a section without flags matches any");
+}
+
+void check_zero_virtual_size(void) {
+    auto sections = parse_sections(make_image({
+        {".text", 0, 0x1000, 0x4200, CNT_CODE | MEM_EXECUTE | MEM_READ},
+    }));
+    check(sections.size() == 1, "parses a section with virtual size 0");
+    if (sections.size() == 1) {
+        check(sections[0].size == 0x4200, "falls back to the raw size if the virtual size is 0");
+    }
+}
+
+void check_no_sections(void) {
+    auto image = make_image({});
+    check(parse_sections(image).empty(), "an image without sections has none");
+}
+
+void check_truncated(void) {
+    auto image = make_image(TYPICAL_SECTIONS);
+
+    // Cut off part way through the last section header
+    auto truncated_table = image;
+    truncated_table.resize(image.size() - (SECTION_HEADER_SIZE / 2));
+    check(parse_sections(truncated_table).empty(), "rejects a truncated section table");
+
+    // Cut off right before the characteristics field of the last section header
+    auto truncated_field = image;
+    truncated_field.resize(image.size() - 4);
+    check(parse_sections(truncated_field).empty(), "rejects a truncated final field");
+
+    // Claim more sections than fit in the buffer
+    auto overcounted = image;
+    write_le<uint16_t>(overcounted, PE_HEADER_OFFSET + 4 + 2,
+                       static_cast<uint16_t>(TYPICAL_SECTIONS.size() + 1));
+    check(parse_sections(overcounted).empty(), "rejects a section count past the end");
+
+    // Cut off in the middle of the file header
+    auto truncated_header = image;
+    truncated_header.resize(PE_HEADER_OFFSET + 4 + 8);
+    check(parse_sections(truncated_header).empty(), "rejects a truncated file header");
+
+    // Cut off before e_lfanew
+    auto truncated_dos = image;
+    truncated_dos.resize(E_LFANEW_OFFSET + 2);
+    check(parse_sections(truncated_dos).empty(), "rejects a truncated dos header");
+
+    check(parse_sections({}).empty(), "rejects an empty buffer");
+}
+
+void check_invalid(void) {
+    auto bad_signature = make_image(TYPICAL_SECTIONS);
+    bad_signature[PE_HEADER_OFFSET] = 'X';
+    check(parse_sections(bad_signature).empty(), "rejects a missing PE signature");
+
+    auto bad_lfanew = make_image(TYPICAL_SECTIONS);
+    write_le<uint32_t>(bad_lfanew, E_LFANEW_OFFSET, 0xFFFFFFF0);
+    check(parse_sections(bad_lfanew).empty(), "rejects e_lfanew past the end");
+
+    auto bad_optional_size = make_image(TYPICAL_SECTIONS);
+    write_le<uint16_t>(bad_optional_size, PE_HEADER_OFFSET + 4 + 16, 0xFFFF);
+    check(parse_sections(bad_optional_size).empty(), "rejects an optional header past the end");
+}
+
+}  // namespace
+
+int main(void) {
+    check_typical_image();
+    check_unusual_flags();
+    check_zero_virtual_size();
+    check_no_sections();
+    check_truncated();
+    check_invalid();
+
+    if (failures > 0) {
+        std::fprintf(stderr, "%zu checks failed\n", failures);
+        return EXIT_FAILURE;
+    }
+    std::printf("All checks passed\n");
+    return EXIT_SUCCESS;
+}
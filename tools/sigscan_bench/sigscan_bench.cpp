@@ -0,0 +1,589 @@
+/*
+Benchmarks the sigscan engine against synthetic exe images.
+
+This builds on its own, on any platform, without the rest of the sdk:
+
+    cmake -S tools/sigscan_bench -B build-bench -DCMAKE_BUILD_TYPE=Release
+    cmake --build build-bench
+    ./build-bench/sigscan_bench [options]
+
+Options:
+    --sizes <mb,...>    The image sizes to test, in megabytes. Defaults to 64,128,256.
+    --threads <n,...>   The thread counts to test. Defaults to 1 and the hardware concurrency.
+    --iterations <n>    How many times to repeat each measurement, keeping the fastest. Defaults
+                        to 3.
+    --src <dir>         The sdk's `src/unrealsdk/game` dir, to read patterns from.
+
+Rather than keeping a copy of the game patterns which would drift out of date, they're parsed
+straight out of the game hook sources, from every `Pattern<n> NAME{ "..." };` declaration.
+
+Each image is filled with bytes following a rough approximation of x86 code - common opcodes,
+small immediates, and int3 padding between "functions" - so that anchor bytes get realistic hit
+rates. Every pattern is then planted once, spread throughout the second half of the image, so that
+each scan needs to get through most of it.
+
+For each image, we measure:
+- Miss throughput: a single scan for a pattern which isn't present, i.e. the full image.
+- Startup: each game's patterns scanned one at a time (as most hooks used to), and all in a single
+  `sigscan_many` pass (as the prescan does).
+
+Every result is checked against where the pattern was planted.
+*/
+
+#include "unrealsdk/sigscan.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <map>
+#include <optional>
+#include <random>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifndef SIGSCAN_BENCH_GAME_DIR
+#define SIGSCAN_BENCH_GAME_DIR "src/unrealsdk/game"
+#endif
+
+using namespace unrealsdk::memory;
+
+namespace {
+
+struct BenchPattern {
+    std::string game;
+    std::string name;
+    std::vector<uint8_t> bytes;
+    std::vector<uint8_t> mask;
+
+    [[nodiscard]] PatternView view(void) const {
+        return {.bytes = this->bytes.data(), .mask = this->mask.data(), .size = this->bytes.size()};
+    }
+};
+
+struct Options {
+    std::vector<size_t> sizes_mb{64, 128, 256};
+    std::vector<size_t> threads{};
+    size_t iterations = 3;
+    std::filesystem::path game_dir = SIGSCAN_BENCH_GAME_DIR;
+};
+
+#pragma region Pattern Parsing
+
+/**
+ * @brief Strips all comments out of a C++ source file.
+ *
+ * @param source The source to strip.
+ * @return The stripped source.
+ */
+std::string strip_comments(const std::string& source) {
+    std::string output{};
+    output.reserve(source.size());
+
+    for (size_t i = 0; i < source.size(); i++) {
+        if (source[i] == '"') {
+            // Copy string literals verbatim, so we don't mistake a "//" inside one for a comment
+            auto end = i + 1;
+            while (end < source.size() && source[end] != '"') {
+                end += (source[end] == '\\') ? 2 : 1;
+            }
+            output.append(source, i, end - i + 1);
+            i = end;
+        } else if (source.compare(i, 2, "//") == 0) {
+            i = source.find('\n', i);
+            if (i == std::string::npos) {
+                break;
+            }
+            output.push_back('\n');
+        } else if (source.compare(i, 2, "/*") == 0) {
+            i = source.find("*/", i);
+            if (i == std::string::npos) {
+                break;
+            }
+            i++;
+        } else {
+            output.push_back(source[i]);
+        }
+    }
+
+    return output;
+}
+
+/**
+ * @brief Converts a pattern hex string into it's bytes and mask, following the same rules as
+ *        `Pattern`'s constructor.
+ *
+ * @param hex The hex string.
+ * @param bytes The vector to write the bytes into.
+ * @param mask The vector to write the mask into.
+ * @return True if the string held a whole number of bytes.
+ */
+bool parse_hex(const std::string& hex, std::vector<uint8_t>& bytes, std::vector<uint8_t>& mask) {
+    bool upper_nibble = true;
+    for (auto character : hex) {
+        if (character == ' ' || character == '{' || character == '}') {
+            continue;
+        }
+
+        uint8_t nibble = 0;
+        uint8_t nibble_mask = 0xF;
+        if ('0' <= character && character <= '9') {
+            nibble = static_cast<uint8_t>(character - '0');
+        } else if ('A' <= character && character <= 'F') {
+            nibble = static_cast<uint8_t>(character - 'A' + 0xA);
+        } else if ('a' <= character && character <= 'f') {
+            nibble = static_cast<uint8_t>(character - 'a' + 0xA);
+        } else {
+            nibble_mask = 0;
+        }
+
+        if (upper_nibble) {
+            bytes.push_back(static_cast<uint8_t>(nibble << 4));
+            mask.push_back(static_cast<uint8_t>(nibble_mask << 4));
+        } else {
+            bytes.back() |= nibble;
+            mask.back() |= nibble_mask;
+        }
+        upper_nibble = !upper_nibble;
+    }
+    return upper_nibble;
+}
+
+/**
+ * @brief Parses all the patterns out of the game hook sources.
+ *
+ * @param game_dir The game hook source dir.
+ * @return The parsed patterns.
+ */
+std::vector<BenchPattern> load_patterns(const std::filesystem::path& game_dir) {
+    static const std::regex decl_regex{R"(Pattern<(\d+)>\s+(\w+)\s*\{([^;]*)\};)"};
+    static const std::regex literal_regex{R"re("([^"]*)")re"};
+
+    std::vector<std::filesystem::path> files{};
+    for (const auto& entry : std::filesystem::recursive_directory_iterator(game_dir)) {
+        if (entry.is_regular_file() && entry.path().extension() == ".cpp") {
+            files.push_back(entry.path());
+        }
+    }
+    std::ranges::sort(files);
+
+    std::vector<BenchPattern> patterns{};
+    for (const auto& file : files) {
+        std::ifstream stream{file};
+        std::stringstream contents{};
+        contents << stream.rdbuf();
+        auto source = strip_comments(contents.str());
+
+        for (auto decl = std::sregex_iterator(source.begin(), source.end(), decl_regex);
+             decl != std::sregex_iterator(); decl++) {
+            BenchPattern pattern{.game = file.parent_path().filename().string(),
+                                 .name = (*decl)[2].str(),
+                                 .bytes = {},
+                                 .mask = {}};
+
+            std::string hex{};
+            auto body = (*decl)[3].str();
+            for (auto literal = std::sregex_iterator(body.begin(), body.end(), literal_regex);
+                 literal != std::sregex_iterator(); literal++) {
+                hex += (*literal)[1].str();
+            }
+
+            auto expected_size = std::stoull((*decl)[1].str());
+            if (!parse_hex(hex, pattern.bytes, pattern.mask)
+                || pattern.bytes.size() != expected_size) {
+                std::fprintf(stderr, "Skipping %s::%s, couldn't parse it's pattern\n",
+                             pattern.game.c_str(), pattern.name.c_str());
+                continue;
+            }
+
+            patterns.push_back(std::move(pattern));
+        }
+    }
+
+    return patterns;
+}
+
+#pragma endregion
+
+#pragma region Image Generation
+
+/**
+ * @brief Generates a buffer of bytes looking vaguely like x86 code.
+ *
+ * @param size The size of the buffer.
+ * @param seed The seed to generate the buffer with.
+ * @return The buffer.
+ */
+std::vector<uint8_t> generate_image(size_t size, uint32_t seed) {
+    // Roughly the most common bytes in a real exe's code section, with weights
+    static const std::vector<std::pair<uint8_t, uint32_t>> common_bytes{
+        {0x00, 60}, {0xFF, 20}, {0x48, 24}, {0x8B, 22}, {0x89, 14}, {0x0F, 10}, {0xE8, 8},
+        {0x4C, 7},  {0x44, 7},  {0x24, 9},  {0x01, 6},  {0x83, 6},  {0x85, 4},  {0x74, 4},
+        {0x75, 4},  {0xC3, 3},  {0x41, 6},  {0x8D, 6},  {0x45, 5},  {0x10, 5},  {0x20, 4},
+        {0x40, 5},  {0xEB, 3},  {0x33, 3},  {0xC0, 4},  {0x08, 4},  {0x18, 3},  {0x28, 3},
+        {0x90, 2},  {0x50, 2},  {0x55, 2},  {0x5D, 2},  {0x6A, 2},  {0x68, 2},  {0x3B, 2},
+    };
+    // The chance, out of 1000, that any given byte is drawn from the above list
+    const constexpr uint32_t common_chance = 700;
+    // The average function length, after which there's a run of int3 padding
+    const constexpr uint32_t avg_function_size = 400;
+    const constexpr uint8_t int3 = 0xCC;
+
+    std::vector<uint32_t> weights{};
+    std::ranges::transform(common_bytes, std::back_inserter(weights),
+                           [](const auto& pair) { return pair.second; });
+
+    std::mt19937 rng{seed};
+    std::discrete_distribution<size_t> common_dist{weights.begin(), weights.end()};
+    std::uniform_int_distribution<uint32_t> chance_dist{0, 999};
+    std::uniform_int_distribution<uint32_t> byte_dist{0, 0xFF};
+    std::uniform_int_distribution<uint32_t> padding_dist{1, 15};
+    std::geometric_distribution<uint32_t> function_dist{1.0 / avg_function_size};
+
+    std::vector<uint8_t> image(size);
+    size_t idx = 0;
+    while (idx < size) {
+        auto function_end = std::min(size, idx + function_dist(rng));
+        for (; idx < function_end; idx++) {
+            image[idx] = chance_dist(rng) < common_chance
+                             ? common_bytes[common_dist(rng)].first
+                             : static_cast<uint8_t>(byte_dist(rng));
+        }
+
+        auto padding_end = std::min(size, idx + padding_dist(rng));
+        for (; idx < padding_end; idx++) {
+            image[idx] = int3;
+        }
+    }
+
+    return image;
+}
+
+/**
+ * @brief Plants every pattern in the second half of an image.
+ *
+ * @param image The image to plant into.
+ * @param patterns The patterns to plant.
+ * @param seed The seed used to fill wildcards.
+ * @return The offset each pattern was planted at.
+ */
+std::vector<size_t> plant_patterns(std::vector<uint8_t>& image,
+                                   const std::vector<BenchPattern>& patterns,
+                                   uint32_t seed) {
+    std::mt19937 rng{seed};
+    std::uniform_int_distribution<uint32_t> byte_dist{0, 0xFF};
+
+    std::vector<size_t> offsets{};
+    auto half = image.size() / 2;
+    auto spacing = half / (patterns.size() + 1);
+    for (size_t i = 0; i < patterns.size(); i++) {
+        const auto& pattern = patterns[i];
+        auto offset = half + ((i + 1) * spacing);
+        for (size_t j = 0; j < pattern.bytes.size(); j++) {
+            auto random = static_cast<uint8_t>(byte_dist(rng));
+            image[offset + j] = (pattern.bytes[j] & pattern.mask[j]) | (random & ~pattern.mask[j]);
+        }
+        offsets.push_back(offset);
+    }
+
+    return offsets;
+}
+
+#pragma endregion
+
+#pragma region Benchmarking
+
+/**
+ * @brief Times a function, keeping the fastest of several runs.
+ *
+ * @param iterations How many times to run the function.
+ * @param func The function to time.
+ * @return The fastest time, in seconds.
+ */
+double time_best(size_t iterations, const std::function<void(void)>& func) {
+    double best = std::numeric_limits<double>::max();
+    for (size_t i = 0; i < iterations; i++) {
+        auto start = std::chrono::steady_clock::now();
+        func();
+        auto end = std::chrono::steady_clock::now();
+        best = std::min(best, std::chrono::duration<double>(end - start).count());
+    }
+    return best;
+}
+
+/**
+ * @brief Checks the results of a set of scans against where the patterns were planted.
+ *
+ * @param image The image which was scanned.
+ * @param patterns The patterns which were scanned for.
+ * @param expected The addresses they were planted at.
+ * @param results The found addresses.
+ * @return The number of patterns which weren't found where they were planted.
+ */
+size_t count_mismatches(const std::vector<uint8_t>& image,
+                        const std::vector<const BenchPattern*>& patterns,
+                        const std::vector<uintptr_t>& expected,
+                        const std::vector<uintptr_t>& results) {
+    size_t mismatches = 0;
+    for (size_t i = 0; i < patterns.size(); i++) {
+        if (results[i] == expected[i]) {
+            continue;
+        }
+
+        // An earlier match is allowed, if the random data happened to contain one - but it must
+        // genuinely match
+        auto base = reinterpret_cast<uintptr_t>(image.data());
+        auto valid_earlier = results[i] != 0 && results[i] >= base && results[i] < expected[i]
+                             && engine::matches_at(reinterpret_cast<const uint8_t*>(results[i]),
+                                                   patterns[i]->view());
+        if (!valid_earlier) {
+            std::fprintf(stderr, "  MISMATCH: %s::%s expected %#zx, got %#zx\n",
+                         patterns[i]->game.c_str(), patterns[i]->name.c_str(),
+                         static_cast<size_t>(expected[i] - base),
+                         static_cast<size_t>(results[i] == 0 ? 0 : results[i] - base));
+            mismatches++;
+        }
+    }
+    return mismatches;
+}
+
+/**
+ * @brief Gets all the implementations the current cpu supports.
+ *
+ * @return The supported implementations.
+ */
+std::vector<engine::SigscanImpl> get_supported_impls(void) {
+    auto best = engine::detect_sigscan_impl();
+    std::vector<engine::SigscanImpl> impls{};
+    for (auto impl : {engine::SigscanImpl::SCALAR, engine::SigscanImpl::SSE2,
+                      engine::SigscanImpl::AVX2}) {
+        if (impl <= best) {
+            impls.push_back(impl);
+        }
+    }
+    return impls;
+}
+
+/**
+ * @brief Runs all benchmarks on a single image size.
+ *
+ * @param options The benchmark options.
+ * @param size_mb The size of the image, in megabytes.
+ * @param patterns The patterns to use.
+ * @return The number of failed correctness checks.
+ */
+size_t bench_size(const Options& options,
+                  size_t size_mb,
+                  const std::vector<BenchPattern>& patterns) {
+    const constexpr uint32_t image_seed = 0x5CA11ED;
+    const constexpr uint32_t plant_seed = 0xBADC0DE;
+
+    auto image = generate_image(size_mb * 1024 * 1024, image_seed);
+    auto offsets = plant_patterns(image, patterns, plant_seed);
+    auto start = reinterpret_cast<uintptr_t>(image.data());
+    auto size = image.size();
+    auto gigabytes = static_cast<double>(size) / 1e9;
+
+    // Group the patterns by game
+    std::map<std::string, std::pair<std::vector<const BenchPattern*>, std::vector<uintptr_t>>>
+        games{};
+    for (size_t i = 0; i < patterns.size(); i++) {
+        auto& [game_patterns, game_expected] = games[patterns[i].game];
+        game_patterns.push_back(&patterns[i]);
+        game_expected.push_back(start + offsets[i]);
+    }
+
+    // The longest pattern, with it's last byte changed so that it's not in the image - i.e. the
+    // slowest case of having to scan the whole thing
+    const auto& longest = *std::ranges::max_element(
+        patterns, {}, [](const auto& pattern) { return pattern.bytes.size(); });
+    auto missing_bytes = longest.bytes;
+    auto missing_mask = longest.mask;
+    missing_bytes.back() = static_cast<uint8_t>(~missing_bytes.back());
+    missing_mask.back() = 0xFF;
+    const PatternView missing{
+        .bytes = missing_bytes.data(), .mask = missing_mask.data(), .size = missing_bytes.size()};
+
+    std::printf("\n=== %zu MB image ===\n", size_mb);
+    std::printf("%-8s %7s %11s", "impl", "threads", "miss GB/s");
+    for (const auto& [game, _] : games) {
+        std::printf(" %10s %10s", (game + " each").c_str(), (game + " many").c_str());
+    }
+    std::printf("\n");
+
+    size_t failures = 0;
+    for (auto impl : get_supported_impls()) {
+        for (auto thread_count : options.threads) {
+            std::printf("%-8s %7zu", std::string{engine::get_sigscan_impl_name(impl)}.c_str(),
+                        thread_count);
+
+            uintptr_t missing_result = 0;
+            auto miss_time = time_best(options.iterations, [&]() {
+                missing_result = engine::sigscan(missing, start, size, impl, thread_count);
+            });
+            if (missing_result != 0) {
+                std::fprintf(stderr, "  MISMATCH: found the missing pattern\n");
+                failures++;
+            }
+            std::printf(" %11.2f", gigabytes / miss_time);
+
+            for (const auto& [game, game_data] : games) {
+                const auto& [game_patterns, game_expected] = game_data;
+                std::vector<PatternView> views{};
+                std::ranges::transform(game_patterns, std::back_inserter(views),
+                                       [](const auto* pattern) { return pattern->view(); });
+
+                std::vector<uintptr_t> each_results(views.size());
+                auto each_time = time_best(options.iterations, [&]() {
+                    for (size_t i = 0; i < views.size(); i++) {
+                        each_results[i] =
+                            engine::sigscan(views[i], start, size, impl, thread_count);
+                    }
+                });
+                failures += count_mismatches(image, game_patterns, game_expected, each_results);
+
+                std::vector<uintptr_t> many_results{};
+                auto many_time = time_best(options.iterations, [&]() {
+                    many_results = engine::sigscan_many(views, start, size, impl, thread_count);
+                });
+                failures += count_mismatches(image, game_patterns, game_expected, many_results);
+
+                std::printf(" %8.1fms %8.1fms", each_time * 1e3, many_time * 1e3);
+            }
+            std::printf("\n");
+            std::fflush(stdout);
+        }
+    }
+
+    return failures;
+}
+
+#pragma endregion
+
+/**
+ * @brief Parses a comma separated list of numbers.
+ *
+ * @param arg The argument to parse.
+ * @return The list of numbers, or an empty list if invalid.
+ */
+std::vector<size_t> parse_list(const std::string& arg) {
+    std::vector<size_t> values{};
+    std::stringstream stream{arg};
+    std::string item{};
+    while (std::getline(stream, item, ',')) {
+        try {
+            auto value = std::stoull(item);
+            if (value == 0) {
+                return {};
+            }
+            values.push_back(value);
+        } catch (const std::exception&) {
+            return {};
+        }
+    }
+    return values;
+}
+
+/**
+ * @brief Parses the command line options.
+ *
+ * @param args The command line args, excluding the program name.
+ * @return The parsed options, or an empty optional if invalid.
+ */
+std::optional<Options> parse_options(const std::vector<std::string>& args) {
+    Options options{};
+    for (size_t i = 0; i < args.size(); i++) {
+        if (i + 1 >= args.size()) {
+            return std::nullopt;
+        }
+        const auto& value = args[++i];
+
+        if (args[i - 1] == "--sizes") {
+            options.sizes_mb = parse_list(value);
+            if (options.sizes_mb.empty()) {
+                return std::nullopt;
+            }
+        } else if (args[i - 1] == "--threads") {
+            options.threads = parse_list(value);
+            if (options.threads.empty()) {
+                return std::nullopt;
+            }
+        } else if (args[i - 1] == "--iterations") {
+            auto iterations = parse_list(value);
+            if (iterations.size() != 1) {
+                return std::nullopt;
+            }
+            options.iterations = iterations.front();
+        } else if (args[i - 1] == "--src") {
+            options.game_dir = value;
+        } else {
+            return std::nullopt;
+        }
+    }
+
+    if (options.threads.empty()) {
+        options.threads.push_back(1);
+        auto hardware = static_cast<size_t>(std::thread::hardware_concurrency());
+        if (hardware > 1) {
+            options.threads.push_back(hardware);
+        }
+    }
+
+    return options;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    auto options = parse_options({argv + 1, argv + argc});
+    if (!options.has_value()) {
+        std::fprintf(stderr,
+                     "Usage: %s [--sizes <mb,...>] [--threads <n,...>] [--iterations <n>] "
+                     "[--src <game dir>]\n",
+                     argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    if (!std::filesystem::is_directory(options->game_dir)) {
+        std::fprintf(stderr, "Couldn't find game source dir: %s\n",
+                     options->game_dir.string().c_str());
+        return EXIT_FAILURE;
+    }
+
+    auto patterns = load_patterns(options->game_dir);
+    if (patterns.empty()) {
+        std::fprintf(stderr, "Couldn't find any patterns in %s\n",
+                     options->game_dir.string().c_str());
+        return EXIT_FAILURE;
+    }
+
+    std::map<std::string, size_t> counts{};
+    for (const auto& pattern : patterns) {
+        counts[pattern.game]++;
+    }
+    std::printf("Loaded %zu patterns:", patterns.size());
+    for (const auto& [game, count] : counts) {
+        std::printf(" %s=%zu", game.c_str(), count);
+    }
+    std::printf("\nBest supported sigscan: %s\n",
+                std::string{engine::get_sigscan_impl_name(engine::detect_sigscan_impl())}.c_str());
+
+    size_t failures = 0;
+    for (auto size_mb : options->sizes_mb) {
+        failures += bench_size(*options, size_mb, patterns);
+    }
+
+    if (failures != 0) {
+        std::printf("\n%zu correctness checks failed\n", failures);
+        return EXIT_FAILURE;
+    }
+    std::printf("\nAll results matched\n");
+    return EXIT_SUCCESS;
+}